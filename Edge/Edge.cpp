@@ -9,7 +9,9 @@
  * @date 17.12.2017
  */
 
+#include <Arduino.h>
 #include "Edge.h"
+#include "SnapshotStream.h"
 #include "Edge_DebugIf.h"  // For debugging macros
 
 /**
@@ -17,7 +19,7 @@
  * @param io_status The initial level of the digital input/output.
  * @param resolution The resolution of the edge occurrence time (microseconds or milliseconds).
  */
-Edge::Edge(uint8_t io_status, EdgeResolution_e res) : m_current_io(io_status)
+Edge::Edge(uint8_t io_status, EdgeResolution_e res) : m_current_io(io_status), m_last_io(EDGE_LOW)
 {
    m_edge_info.m_edge = EDGE_NO_EDGE;
    m_edge_info.m_time = 0u;
@@ -32,9 +34,14 @@ Edge::~Edge()
 
 void Edge::checkEdges(void)
 {
-   static uint8_t old_io = EDGE_LOW;
+#if EDGE_TIME_64BIT == 1
+   /* Read the clock on every poll, so the high word follows each wrap even
+    * while the input level does not change.
+    */
+   (void)time();
+#endif
 
-   if (old_io == EDGE_LOW && m_current_io == EDGE_HIGH)
+   if (m_last_io == EDGE_LOW && m_current_io == EDGE_HIGH)
    {
       m_edge_info.m_edge = EDGE_RISING;
       m_edge_info.m_time = time();
@@ -48,9 +55,9 @@ void Edge::checkEdges(void)
 #endif
 
       DBIF_LOG_DEBUG_0("... Rising Edge Detected ...");
-      DBIF_LOG_DEBUG_1("... At Time = %i ...", m_edge_info.m_time);
+      DBIF_LOG_DEBUG_1("... At Time = %i ...", (uint32_t)m_edge_info.m_time);
    }
-   else if (old_io == EDGE_HIGH && m_current_io == EDGE_LOW)
+   else if (m_last_io == EDGE_HIGH && m_current_io == EDGE_LOW)
    {
       m_edge_info.m_edge = EDGE_FALLING;
       m_edge_info.m_time = time();
@@ -65,7 +72,7 @@ void Edge::checkEdges(void)
 #endif
 
       DBIF_LOG_DEBUG_0("... Falling Edge Detected ...");
-      DBIF_LOG_DEBUG_1("... At Time = %i ...", m_edge_info.m_time);
+      DBIF_LOG_DEBUG_1("... At Time = %i ...", (uint32_t)m_edge_info.m_time);
    }
    else
    {
@@ -73,7 +80,7 @@ void Edge::checkEdges(void)
       m_edge_info.m_time = 0;
    }
 
-   old_io = m_current_io;
+   m_last_io = m_current_io;
    return;
 }
 
@@ -103,7 +110,7 @@ EdgeType_e Edge::getCurrentEdge(void) const
 }
 
 
-uint32_t Edge::getCurrentEdgeTime(void) const
+EdgeTime_t Edge::getCurrentEdgeTime(void) const
 {
    return m_edge_info.m_time;
 }
@@ -122,10 +129,77 @@ EdgeResolution_e Edge::resolution(void)
 }
 
 
-uint32_t Edge::time(void)
+void Edge::saveState(SnapshotWriter &writer) const
 {
-   if (m_resolution == EDGE_RESOLUTION_US)
-      return micros();
-   else
-      return millis();
+   writer.writeU8(m_current_io);
+   writer.writeU8(m_last_io);
+   writer.writeU8(static_cast<uint8_t>(m_edge_info.m_edge));
+   writer.writeU8(static_cast<uint8_t>(m_resolution));
+   writer.writeTime(m_edge_info.m_time);
+   writer.writeTime(time());
+}
+
+
+bool Edge::restoreState(SnapshotReader &reader)
+{
+   EdgeTime_t shift;
+   return restoreState(reader, shift);
+}
+
+
+bool Edge::restoreState(SnapshotReader &reader, EdgeTime_t &shift)
+{
+   uint8_t current_io = reader.readU8();
+   uint8_t last_io = reader.readU8();
+   uint8_t edge = reader.readU8();
+   uint8_t res = reader.readU8();
+   EdgeTime_t edge_time = reader.readTime();
+   EdgeTime_t saved_time = reader.readTime();
+
+   if (!reader.isValid() || current_io > EDGE_HIGH || last_io > EDGE_HIGH ||
+       edge > EDGE_FALLING || res > EDGE_RESOLUTION_MS)
+   {
+      DBIF_LOG_DEBUG_0("... Invalid Snapshot ...");
+      shift = 0;
+      return false;
+   }
+
+   m_current_io = current_io;
+   m_last_io = last_io;
+   m_resolution = static_cast<EdgeResolution_e>(res);
+   m_edge_info.m_edge = static_cast<EdgeType_e>(edge);
+   m_edge_info.m_time = edge_time;
+
+   /* Continue as if no time has passed between saving and restoring */
+   shift = time() - saved_time;
+   if (m_edge_info.m_edge != EDGE_NO_EDGE)
+   {
+      m_edge_info.m_time += shift;
+   }
+   return true;
+}
+
+
+EdgeTime_t Edge::time(void) const
+{
+   return clock(m_resolution);
+}
+
+
+EdgeTime_t Edge::clock(EdgeResolution_e resolution)
+{
+   uint32_t now = (resolution == EDGE_RESOLUTION_US) ? micros() : millis();
+#if EDGE_TIME_64BIT == 1
+   static uint32_t last[2] = {0u, 0u};
+   static uint32_t high[2] = {0u, 0u};
+
+   if (now < last[resolution])
+   {
+      high[resolution]++;
+   }
+   last[resolution] = now;
+   return (static_cast<uint64_t>(high[resolution]) << 32) | now;
+#else
+   return now;
+#endif
 }
\ No newline at end of file
@@ -16,12 +16,35 @@
 #include <stdint.h>
 #include "Event.h"
 
+class SnapshotWriter;
+class SnapshotReader;
+
 #define EDGE_USE_EVENTS 0
 #define EDGE_USE_CALLBACKS 1
 
 
 #define EDGE_ENABLE_EVENT_OUTPUT EDGE_USE_EVENTS
 
+/**
+ * @brief Set to 1 to carry all timestamps, widths and timeouts as 64 bit values.
+ *
+ * The 32 bit Arduino clock is extended by a high word which is counted up whenever
+ * the clock is read with a smaller value than before. This costs one compare per
+ * clock read and requires at least one read per wrap period (about 71 minutes with
+ * microsecond resolution), so checkEdges() reads the clock on every call.
+ * Keep it at 0 on memory constrained targets to stay with 32 bit timestamps.
+ */
+#ifndef EDGE_TIME_64BIT
+#define EDGE_TIME_64BIT 0
+#endif
+
+#if EDGE_TIME_64BIT == 1
+typedef uint64_t EdgeTime_t;     /**< Timestamp, width or timeout. */
+typedef int64_t EdgeTimeDiff_t;  /**< Signed difference of two timestamps. */
+#else
+typedef uint32_t EdgeTime_t;     /**< Timestamp, width or timeout. */
+typedef int32_t EdgeTimeDiff_t;  /**< Signed difference of two timestamps. */
+#endif
 
 /**
  * @brief Macro definition for low edge status.
@@ -62,7 +85,7 @@ typedef enum
 typedef struct
 {
    EdgeType_e m_edge; /**< Type of the detected edge */
-   uint32_t m_time;   /**< Time at which the edge was detected */
+   EdgeTime_t m_time; /**< Time at which the edge was detected */
 } EdgeInfo_t;
 
 /**
@@ -89,6 +112,13 @@ public:
     */
    Edge(const Edge &) = default;
 
+   /**
+    * @brief Copy assignment operator for the Edge class.
+    * @param edge The Edge object to be copied.
+    * @return This object.
+    */
+   Edge &operator=(const Edge &) = default;
+
    /**
     * @brief Checks for edge occurrences based on current and previous input levels.
     */
@@ -114,9 +144,9 @@ public:
 
    /**
     * @brief Gets the occurrence time of the current edge.
-    * @return The time in microseconds or milliseconds (uint32_t).
+    * @return The time in microseconds or milliseconds (EdgeTime_t).
     */
-   uint32_t getCurrentEdgeTime(void) const;
+   EdgeTime_t getCurrentEdgeTime(void) const;
 
    /**
     * @brief Assignment operator for edge information.
@@ -137,15 +167,52 @@ public:
     */
    EdgeResolution_e resolution(void);
 
+   /**
+    * @brief Writes the detector state into a snapshot.
+    * @param writer The snapshot writer.
+    */
+   void saveState(SnapshotWriter &writer) const;
+
+   /**
+    * @brief Restores the detector state from a snapshot.
+    * @param reader The snapshot reader.
+    * @return true if the state was valid and has been restored. On false the object is unchanged.
+    */
+   bool restoreState(SnapshotReader &reader);
+
+   /**
+    * @brief Reads the clock shared by all detectors with the given resolution.
+    *
+    * With EDGE_TIME_64BIT the 32 bit clock is extended to 64 bit here. The extension
+    * is not interrupt safe, so read the clock from a single context only.
+    *
+    * @param resolution The resolution of the clock.
+    * @return The current time in microseconds or milliseconds (EdgeTime_t).
+    */
+   static EdgeTime_t clock(EdgeResolution_e resolution);
+
+protected:
+   /**
+    * @brief Restores the detector state from a snapshot.
+    *
+    * Only the Edge part is validated. Derived classes reading more fields have
+    * to restore into a copy to leave the object unchanged on an invalid image.
+    * @param reader The snapshot reader.
+    * @param shift Returns the offset between the saved and the current time base.
+    * @return true if the state was valid and has been restored.
+    */
+   bool restoreState(SnapshotReader &reader, EdgeTime_t &shift);
+
 private:
    /**
     * @brief Retrieves the current time based on the configured resolution.
-    * @return The current time in microseconds or milliseconds (uint32_t).
+    * @return The current time in microseconds or milliseconds (EdgeTime_t).
     */
-   uint32_t time(void);
+   EdgeTime_t time(void) const;
 
 private:
    uint8_t m_current_io;           /**< Current I/O status. */
+   uint8_t m_last_io;              /**< I/O status seen by the previous checkEdges() call. */
    EdgeInfo_t m_edge_info;         /**< Structure holding the edge information. */
    EdgeResolution_e m_resolution;  /**< Resolution of the edge detection. */
 #if EDGE_ENABLE_EVENT_OUTPUT == EDGE_USE_CALLBACKS
@@ -0,0 +1,293 @@
+/**
+ * @file Envelope.cpp
+ * @brief Implementation file for the Envelope class for decimated signal summaries.
+ *
+ * This file contains the method implementations for the Envelope class, providing
+ * the incremental window accounting of all levels and the window queries.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "Envelope.h"
+#include "Envelope_DebugIf.h"  // For debugging macros
+
+/**
+ * @brief Constructor for the Envelope class, starting at the first edge or advance() call.
+ * @param io_status The initial signal level.
+ */
+Envelope::Envelope(uint8_t io_status) :
+   m_level_count(0), m_io(io_status), m_time(0), m_started(false), m_puls_count(0)
+{
+}
+
+/**
+ * @brief Constructor for the Envelope class.
+ * @param io_status The initial signal level.
+ * @param time The start time of the first windows.
+ */
+Envelope::Envelope(uint8_t io_status, EdgeTime_t time) :
+   m_level_count(0), m_io(io_status), m_time(time), m_started(true), m_puls_count(0)
+{
+}
+
+Envelope::~Envelope()
+{
+   // Destructor logic if needed
+}
+
+
+int8_t Envelope::addLevel(EdgeTime_t window)
+{
+   if (m_level_count >= ENVELOPE_MAX_LEVELS || window == 0)
+   {
+      DBIF_LOG_WARN("Level invalid = %i", (uint32_t)window);
+      return ENVELOPE_INVALID;
+   }
+
+   EnvelopeLevel_t &level = m_levels[m_level_count];
+   level.m_window = window;
+   level.m_accounted = m_time;
+   level.m_head = 0;
+   level.m_count = 0;
+   resetWindow(level.m_open, m_time);
+
+   DBIF_LOG_DEBUG_1("Level added = %i", (uint32_t)window);
+   return static_cast<int8_t>(m_level_count++);
+}
+
+
+void Envelope::addEdge(EdgeType_e edge, EdgeTime_t time)
+{
+   if (edge == EDGE_NO_EDGE)
+   {
+      return;
+   }
+
+   advance(time);
+   m_io = (edge == EDGE_RISING) ? EDGE_HIGH : EDGE_LOW;
+
+   for (uint8_t i = 0; i < m_level_count; i++)
+   {
+      m_levels[i].m_open.m_edges++;
+   }
+}
+
+
+void Envelope::addPuls(EdgeTime_t width)
+{
+   for (uint8_t i = 0; i < m_level_count; i++)
+   {
+      EnvelopeWindow_t &open = m_levels[i].m_open;
+
+      if (open.m_pulses == 0 || width < open.m_min_width)
+         open.m_min_width = width;
+      if (open.m_pulses == 0 || width > open.m_max_width)
+         open.m_max_width = width;
+      open.m_pulses++;
+   }
+}
+
+
+void Envelope::update(Edge &edge)
+{
+   EdgeInfo_t info = edge.info();
+   addEdge(info.m_edge, info.m_time);
+}
+
+
+void Envelope::update(Puls &puls)
+{
+   uint32_t count = puls.getPulsCount();
+
+   if (count != m_puls_count)
+   {
+      m_puls_count = count;
+      PulsType_e type = puls.getPulsType();
+      if (type == PULS_HIGH || type == PULS_LOW)
+      {
+         /* Put the pulse into the window of its end edge, also without update(Edge &) */
+         advance(puls.getPulsTime());
+         addPuls(static_cast<EdgeTime_t>(puls.getPulsWidth()));
+      }
+   }
+}
+
+
+void Envelope::advance(EdgeTime_t time)
+{
+   if (!m_started)
+   {
+      /* The first time seen starts the windows of all levels */
+      m_started = true;
+      m_time = time;
+      for (uint8_t i = 0; i < m_level_count; i++)
+      {
+         m_levels[i].m_accounted = time;
+         m_levels[i].m_open.m_start = time;
+      }
+   }
+
+   if (static_cast<EdgeTimeDiff_t>(time - m_time) < 0)
+   {
+      DBIF_LOG_WARN("Time out of order = %i", (uint32_t)time);
+      return;
+   }
+
+   for (uint8_t i = 0; i < m_level_count; i++)
+   {
+      advanceLevel(m_levels[i], time);
+   }
+   m_time = time;
+}
+
+
+uint16_t Envelope::count(uint8_t level) const
+{
+   return level < m_level_count ? m_levels[level].m_count : 0;
+}
+
+
+bool Envelope::window(uint8_t level, uint16_t index, EnvelopeWindow_t &window) const
+{
+   if (level >= m_level_count || index >= m_levels[level].m_count)
+   {
+      return false;
+   }
+
+   const EnvelopeLevel_t &lvl = m_levels[level];
+   window = lvl.m_ring[(lvl.m_head + ENVELOPE_DEPTH - 1u - index) % ENVELOPE_DEPTH];
+   return true;
+}
+
+
+bool Envelope::current(uint8_t level, EnvelopeWindow_t &window) const
+{
+   if (level >= m_level_count)
+   {
+      return false;
+   }
+   window = m_levels[level].m_open;
+   return true;
+}
+
+
+uint16_t Envelope::summary(uint8_t level, EdgeTime_t from, EdgeTime_t to, EnvelopeWindow_t &result) const
+{
+   uint16_t merged = 0;
+
+   resetWindow(result, from);
+   if (level >= m_level_count)
+   {
+      return 0;
+   }
+
+   /* Walk from the oldest to the newest window, the range check is done on
+    * differences to stay valid when the timer wraps around.
+    */
+   const EnvelopeLevel_t &lvl = m_levels[level];
+   for (uint16_t index = lvl.m_count; index > 0; index--)
+   {
+      const EnvelopeWindow_t &w = lvl.m_ring[(lvl.m_head + ENVELOPE_DEPTH - index) % ENVELOPE_DEPTH];
+      if ((w.m_start - from) < (to - from))
+      {
+         if (merged == 0)
+         {
+            result.m_start = w.m_start;
+         }
+         mergeWindow(result, w);
+         merged++;
+      }
+   }
+   return merged;
+}
+
+
+void Envelope::clear(EdgeTime_t time)
+{
+   m_time = time;
+   m_started = true;
+   for (uint8_t i = 0; i < m_level_count; i++)
+   {
+      EnvelopeLevel_t &level = m_levels[i];
+      level.m_accounted = time;
+      level.m_head = 0;
+      level.m_count = 0;
+      resetWindow(level.m_open, time);
+   }
+}
+
+
+void Envelope::advanceLevel(EnvelopeLevel_t &level, EdgeTime_t time)
+{
+   while ((time - level.m_open.m_start) >= level.m_window)
+   {
+      EdgeTime_t end = level.m_open.m_start + level.m_window;
+
+      addSpan(level, end);
+      level.m_ring[level.m_head] = level.m_open;
+      level.m_head = (level.m_head + 1u) % ENVELOPE_DEPTH;
+      if (level.m_count < ENVELOPE_DEPTH)
+      {
+         level.m_count++;
+      }
+      resetWindow(level.m_open, end);
+
+      /* After a long idle phase only the last ENVELOPE_DEPTH windows survive
+       * in the ring, so the older idle windows are skipped instead of closed
+       * one by one. This bounds the work per call by the ring size.
+       */
+      EdgeTime_t idle = (time - end) / level.m_window;
+      if (idle > ENVELOPE_DEPTH)
+      {
+         EdgeTime_t skipped = (idle - ENVELOPE_DEPTH) * level.m_window;
+         level.m_open.m_start += skipped;
+         level.m_accounted = level.m_open.m_start;
+      }
+   }
+   addSpan(level, time);
+}
+
+
+void Envelope::addSpan(EnvelopeLevel_t &level, EdgeTime_t end)
+{
+   EdgeTime_t span = end - level.m_accounted;
+
+   if (m_io == EDGE_HIGH)
+      level.m_open.m_high_time += span;
+   else
+      level.m_open.m_low_time += span;
+
+   level.m_open.m_length += span;
+   level.m_accounted = end;
+}
+
+
+void Envelope::resetWindow(EnvelopeWindow_t &window, EdgeTime_t start)
+{
+   window.m_start = start;
+   window.m_length = 0;
+   window.m_high_time = 0;
+   window.m_low_time = 0;
+   window.m_edges = 0;
+   window.m_pulses = 0;
+   window.m_min_width = 0;
+   window.m_max_width = 0;
+}
+
+
+void Envelope::mergeWindow(EnvelopeWindow_t &target, const EnvelopeWindow_t &source)
+{
+   if (source.m_pulses > 0)
+   {
+      if (target.m_pulses == 0 || source.m_min_width < target.m_min_width)
+         target.m_min_width = source.m_min_width;
+      if (target.m_pulses == 0 || source.m_max_width > target.m_max_width)
+         target.m_max_width = source.m_max_width;
+   }
+   target.m_length += source.m_length;
+   target.m_high_time += source.m_high_time;
+   target.m_low_time += source.m_low_time;
+   target.m_edges += source.m_edges;
+   target.m_pulses += source.m_pulses;
+}
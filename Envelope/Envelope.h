@@ -0,0 +1,200 @@
+/**
+ * @file Envelope.h
+ * @brief Header file for the Envelope class for decimated signal summaries.
+ *
+ * The Envelope class keeps per-window summaries of a signal instead of every
+ * edge: high time, low time, number of edges and the min / max pulse width.
+ * Several levels with growing window lengths are maintained incrementally from
+ * the same edge stream, each in a ring buffer of ENVELOPE_DEPTH closed windows.
+ * Memory is bounded by the number of levels and zoomed-out queries only touch
+ * the few windows of a coarse level.
+ *
+ * Every level keeps window length * ENVELOPE_DEPTH of history, so the coarsest
+ * level has to be sized for the wanted retention. E.g. 10 ms, 10 s and 15 min
+ * windows with the default depth of 16 keep 160 ms, 160 s and 4 h.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _ENVELOPE_H_
+#define _ENVELOPE_H_
+
+#include <stdint.h>
+#include "Edge.h"
+#include "Puls.h"
+
+/**
+ * @brief Maximum number of resolution levels.
+ */
+#ifndef ENVELOPE_MAX_LEVELS
+#define ENVELOPE_MAX_LEVELS 3u
+#endif
+
+/**
+ * @brief Number of closed windows kept per level. The history of a level is
+ * its window length times this depth.
+ */
+#ifndef ENVELOPE_DEPTH
+#define ENVELOPE_DEPTH 16u
+#endif
+
+/**
+ * @brief Return value for an invalid level.
+ */
+#define ENVELOPE_INVALID -1
+
+/**
+ * @brief Structure holding the summary of one window.
+ */
+typedef struct
+{
+   EdgeTime_t m_start;     /**< Start time of the window */
+   EdgeTime_t m_length;    /**< Covered time */
+   EdgeTime_t m_high_time; /**< Time the signal was high */
+   EdgeTime_t m_low_time;  /**< Time the signal was low */
+   uint32_t m_edges;       /**< Number of edges */
+   uint32_t m_pulses;      /**< Number of accepted pulses */
+   EdgeTime_t m_min_width; /**< Smallest pulse width, only valid if m_pulses > 0 */
+   EdgeTime_t m_max_width; /**< Largest pulse width, only valid if m_pulses > 0 */
+} EnvelopeWindow_t;
+
+/**
+ * @brief Class maintaining multi-resolution envelope levels of a signal.
+ */
+class Envelope
+{
+public:
+   /**
+    * @brief Constructor for the Envelope class.
+    *
+    * The first windows start at the time of the first addEdge() / advance() call.
+    * @param io_status The initial signal level.
+    */
+   Envelope(uint8_t io_status = EDGE_LOW);
+
+   /**
+    * @brief Constructor for the Envelope class.
+    * @param io_status The initial signal level.
+    * @param time The start time of the first windows.
+    */
+   Envelope(uint8_t io_status, EdgeTime_t time);
+
+   /**
+    * @brief Destructor for the Envelope class.
+    */
+   virtual ~Envelope();
+
+   /**
+    * @brief Adds a resolution level. Its first window starts at the time of the last edge.
+    * @param window The window length in the time unit of the edges.
+    * @return The level index or ENVELOPE_INVALID if no level is left or the length is 0.
+    */
+   int8_t addLevel(EdgeTime_t window);
+
+   /**
+    * @brief Adds an edge to all levels.
+    * @param edge The edge type.
+    * @param time The edge time.
+    */
+   void addEdge(EdgeType_e edge, EdgeTime_t time);
+
+   /**
+    * @brief Adds a pulse width to the open windows of all levels.
+    * @param width The pulse width.
+    */
+   void addPuls(EdgeTime_t width);
+
+   /**
+    * @brief Adds the current edge of an Edge object.
+    *
+    * Has to be called once after every checkEdges().
+    * @param edge The Edge object.
+    */
+   void update(Edge &edge);
+
+   /**
+    * @brief Adds the last pulse of a Puls object, if it was accepted since the last call.
+    *
+    * Has to be called after every checkPuls(). The windows are advanced to the end
+    * of the pulse before its width is added. High and low times are based on the
+    * edges given by addEdge() / update(Edge &).
+    * @param puls The Puls object.
+    */
+   void update(Puls &puls);
+
+   /**
+    * @brief Closes all windows which ended before time.
+    * @param time The current time.
+    */
+   void advance(EdgeTime_t time);
+
+   /**
+    * @brief Gets the number of closed windows of a level.
+    * @param level The level index.
+    * @return The number of stored windows.
+    */
+   uint16_t count(uint8_t level) const;
+
+   /**
+    * @brief Gets a closed window.
+    * @param level The level index.
+    * @param index The window index, 0 is the most recent one.
+    * @param window The window summary.
+    * @return true if the window exists.
+    */
+   bool window(uint8_t level, uint16_t index, EnvelopeWindow_t &window) const;
+
+   /**
+    * @brief Gets the open window of a level.
+    * @param level The level index.
+    * @param window The window summary up to the last edge or advance() call.
+    * @return true if the level exists.
+    */
+   bool current(uint8_t level, EnvelopeWindow_t &window) const;
+
+   /**
+    * @brief Merges all closed windows of a level starting within [from, to).
+    * @param level The level index.
+    * @param from The start of the query range.
+    * @param to The end of the query range.
+    * @param result The merged summary.
+    * @return The number of merged windows.
+    */
+   uint16_t summary(uint8_t level, EdgeTime_t from, EdgeTime_t to, EnvelopeWindow_t &result) const;
+
+   /**
+    * @brief Drops all windows and starts again at time.
+    * @param time The start time of the first windows.
+    */
+   void clear(EdgeTime_t time);
+
+private:
+   /**
+    * @brief Structure holding the state of one level.
+    */
+   typedef struct
+   {
+      EdgeTime_t m_window;                      /**< Window length */
+      EdgeTime_t m_accounted;                   /**< Time up to which m_open holds high / low time */
+      EnvelopeWindow_t m_open;                  /**< Window being filled */
+      EnvelopeWindow_t m_ring[ENVELOPE_DEPTH];  /**< Closed windows */
+      uint16_t m_head;                          /**< Index of the next ring entry */
+      uint16_t m_count;                         /**< Number of closed windows */
+   } EnvelopeLevel_t;
+
+   void advanceLevel(EnvelopeLevel_t &level, EdgeTime_t time);
+   void addSpan(EnvelopeLevel_t &level, EdgeTime_t end);
+   static void resetWindow(EnvelopeWindow_t &window, EdgeTime_t start);
+   static void mergeWindow(EnvelopeWindow_t &target, const EnvelopeWindow_t &source);
+
+private:
+   EnvelopeLevel_t m_levels[ENVELOPE_MAX_LEVELS]; /**< Resolution levels */
+   uint8_t m_level_count;                         /**< Number of used levels */
+   uint8_t m_io;                                  /**< Current signal level */
+   EdgeTime_t m_time;                             /**< Time of the last edge or advance() call */
+   bool m_started;                                /**< False until the start time is known */
+   uint32_t m_puls_count;                         /**< Last seen pulse count of update(Puls &) */
+};
+
+#endif /* _ENVELOPE_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include "Puls.h"
+#include "SnapshotStream.h"
 #include "Puls_DebugIf.h"
 
 
@@ -15,7 +16,7 @@ Puls::~Puls()
 
 }
 
-Puls::Puls(PulsType_e trigger, uint8_t dio_init_level, uint32_t timeout_time, uint32_t debounce_time) : Edge(dio_init_level)
+Puls::Puls(PulsType_e trigger, uint8_t dio_init_level, EdgeTime_t timeout_time, EdgeTime_t debounce_time) : Edge(dio_init_level)
 {
    init(trigger,timeout_time,debounce_time, PULS_RESOLUTION_MS);
 }
@@ -26,10 +27,14 @@ void Puls::clear(void)
     m_current_puls_width = 0;
     m_puls_count = 0;
    m_error_count = 0;
-
+   m_width_filter_samples = 0;
+   m_width_filter = 0;
+   m_rate_filter_samples = 0;
+   m_rate_time = 0;
+   m_rate_period = 0;
 }
 
-void Puls::init(PulsType_e trigger, int32_t timeout_time, uint32_t debounce_time, PulsResolution_e resolution)
+void Puls::init(PulsType_e trigger, EdgeTime_t timeout_time, EdgeTime_t debounce_time, PulsResolution_e resolution)
 {
    m_current_puls_type = PULS_NO_PULS;
    m_current_puls_width = 0;
@@ -40,6 +45,17 @@ void Puls::init(PulsType_e trigger, int32_t timeout_time, uint32_t debounce_time
 
    m_current_edge = { EDGE_NO_EDGE, 0u, };
    m_last_edge = { EDGE_NO_EDGE, 0u,};
+   m_timeout_start = 0u;
+   m_puls_time = 0u;
+
+   m_width_filter_shift = PULS_FILTER_DISABLED;
+   m_width_filter_samples = 0;
+   m_width_filter = 0u;
+   m_rate_alpha_shift = PULS_FILTER_DISABLED;
+   m_rate_beta_shift = PULS_FILTER_DISABLED;
+   m_rate_filter_samples = 0;
+   m_rate_time = 0u;
+   m_rate_period = 0u;
    
    pulsResolution(resolution);
    enablePulsTimeout(timeout_time);
@@ -49,8 +65,6 @@ void Puls::init(PulsType_e trigger, int32_t timeout_time, uint32_t debounce_time
 
 void Puls::checkPuls(uint8_t pinStatus)
 {
-   
-   static uint32_t timeoutTime = 0;
    boolean pulsDetected = false;
   
    Edge::setStatus(pinStatus);
@@ -74,7 +88,7 @@ void Puls::checkPuls(uint8_t pinStatus)
             m_current_puls_type = PULS_TRIGGERED_HIGH;
 
             DBIF_LOG_DEBUG_0("HIGH_PULS: PULS START");
-            DBIF_LOG_DEBUG_1("WIDTH_START = %i",m_current_puls_width);
+            DBIF_LOG_DEBUG_1("WIDTH_START = %i",(uint32_t)m_current_puls_width);
          }
          else if(m_current_edge.m_edge == EDGE_RISING && pinStatus == HIGH && m_current_puls_type == PULS_TRIGGERED_HIGH)
          {
@@ -103,7 +117,7 @@ void Puls::checkPuls(uint8_t pinStatus)
             m_current_puls_type = PULS_TRIGGERED_LOW;
             
             DBIF_LOG_DEBUG_0("LOW_PULS: PULS START");
-            DBIF_LOG_DEBUG_1("WIDTH_START = %i",m_current_puls_width);
+            DBIF_LOG_DEBUG_1("WIDTH_START = %i",(uint32_t)m_current_puls_width);
          }
          else if(m_current_edge.m_edge == EDGE_FALLING && pinStatus == LOW && m_current_puls_type == PULS_TRIGGERED_LOW)
          {
@@ -151,9 +165,11 @@ void Puls::checkPuls(uint8_t pinStatus)
          else
          {
             m_puls_count ++;
-            DBIF_LOG_DEBUG_1("WIDTH =  (%i - %i) = %i ",m_current_edge.m_time,
-                                                               m_last_edge.m_time,
-                                                               m_current_puls_width);    
+            m_puls_time = m_current_edge.m_time;
+            updateFilters();
+            DBIF_LOG_DEBUG_1("WIDTH =  (%i - %i) = %i ",(uint32_t)m_current_edge.m_time,
+                                                               (uint32_t)m_last_edge.m_time,
+                                                               (uint32_t)m_current_puls_width);    
          }
          
          m_current_edge = {
@@ -168,12 +184,12 @@ void Puls::checkPuls(uint8_t pinStatus)
        */
       if(m_puls_timeout_status == PULS_TIMEOUT_ENABLED)
       {
-         timeoutTime = time();
+         m_timeout_start = time();
       }
    }
    else
    {
-      checkTimeout(timeoutTime);
+      checkTimeout(m_timeout_start);
    }
    return;
 }
@@ -185,14 +201,15 @@ PulsType_e Puls::getPulsType(void)
 }
 
 
-int32_t Puls::getPulsWidth(void)
+EdgeTimeDiff_t Puls::getPulsWidth(void)
 {
-   int32_t width = 0;
+   EdgeTimeDiff_t width = 0;
 
    if((m_current_puls_type == PULS_TRIGGERED_HIGH) || 
       (m_current_puls_type == PULS_TRIGGERED_LOW))
    {
-       width = time() - m_current_puls_width;
+       /* m_last_edge holds the edge which started the puls */
+       width = time() - m_last_edge.m_time;
        return width;
    }
    else
@@ -219,17 +236,17 @@ uint32_t Puls::getErrorCount(void)
 }
 
 
-void Puls::enablePulsTimeout(uint32_t timeout_time)
+void Puls::enablePulsTimeout(EdgeTime_t timeout_time)
 {
    if(timeout_time > 0)
    {
       m_puls_timeout = timeout_time;
       m_puls_timeout_status = PULS_TIMEOUT_ENABLED;
-      DBIF_LOG_INFO("Timeout enbaled = %ims", timeout_time);
+      DBIF_LOG_INFO("Timeout enbaled = %ims", (uint32_t)timeout_time);
    }
    else
    {
-      DBIF_LOG_WARN("Timeout invalid = %ims", timeout_time);
+      DBIF_LOG_WARN("Timeout invalid = %ims", (uint32_t)timeout_time);
       disablePulsTimeout();
       
    }
@@ -254,17 +271,17 @@ uint32_t Puls::getPulsCount(void)
     return m_puls_count;
 }
 
-void Puls::enableDebounce(uint32_t debounce_time)
+void Puls::enableDebounce(EdgeTime_t debounce_time)
 {
    if(debounce_time > 0)
    {
       m_puls_debounce_time = debounce_time;
       m_puls_debouncing_status = PULS_DEBOUNCING_ENABLED;
-      DBIF_LOG_INFO("Debouncing enbaled = %ims", debounce_time);
+      DBIF_LOG_INFO("Debouncing enbaled = %ims", (uint32_t)debounce_time);
    }
    else
       disableDebounce();
-      DBIF_LOG_WARN("Debouncing invalid = %ims", debounce_time);
+      DBIF_LOG_WARN("Debouncing invalid = %ims", (uint32_t)debounce_time);
 
    return;
 }
@@ -275,6 +292,72 @@ void Puls::disableDebounce(void)
    m_puls_debouncing_status = PULS_DEBOUNCING_DISABLED;
 }
 
+EdgeTime_t Puls::getPulsTime(void)
+{
+   return m_puls_time;
+}
+
+EdgeTime_t Puls::getDebounceTime(void)
+{
+   return m_puls_debounce_time;
+}
+
+void Puls::enableWidthFilter(uint8_t shift)
+{
+   if(shift > PULS_FILTER_DISABLED && shift < 8u * sizeof(EdgeTime_t))
+   {
+      m_width_filter_shift = shift;
+      m_width_filter_samples = 0;
+      DBIF_LOG_INFO("Width filter enabled = %i", shift);
+   }
+   else
+   {
+      disableWidthFilter();
+   }
+}
+
+void Puls::disableWidthFilter(void)
+{
+   m_width_filter_shift = PULS_FILTER_DISABLED;
+   m_width_filter_samples = 0;
+   m_width_filter = 0;
+}
+
+EdgeTime_t Puls::getSmoothedWidth(void)
+{
+   return m_width_filter >> m_width_filter_shift;
+}
+
+void Puls::enableRateFilter(uint8_t alpha_shift, uint8_t beta_shift)
+{
+   if(alpha_shift > PULS_FILTER_DISABLED && alpha_shift < 8u * sizeof(EdgeTime_t) &&
+      beta_shift > PULS_FILTER_DISABLED && beta_shift < 8u * sizeof(EdgeTime_t))
+   {
+      m_rate_alpha_shift = alpha_shift;
+      m_rate_beta_shift = beta_shift;
+      m_rate_filter_samples = 0;
+      DBIF_LOG_INFO("Rate filter enabled = %i / %i", alpha_shift, beta_shift);
+   }
+   else
+   {
+      disableRateFilter();
+   }
+}
+
+void Puls::disableRateFilter(void)
+{
+   m_rate_alpha_shift = PULS_FILTER_DISABLED;
+   m_rate_beta_shift = PULS_FILTER_DISABLED;
+   m_rate_filter_samples = 0;
+   m_rate_time = 0;
+   m_rate_period = 0;
+}
+
+EdgeTime_t Puls::getSmoothedPeriod(void)
+{
+   return m_rate_period >> PULS_FILTER_FRACTION_BITS;
+}
+
 void Puls::pulsResolution(PulsResolution_e new_resolution)
 {  
    Edge::resolution(static_cast<EdgeResolution_e>(new_resolution));
@@ -286,15 +369,131 @@ PulsResolution_e Puls::pulsResolution(void)
    return m_puls_resolution;
 }
 
-uint32_t  Puls::time(void)
+void Puls::saveState(SnapshotWriter &writer) const
+{
+   Edge::saveState(writer);
+
+   writer.writeU8(static_cast<uint8_t>(m_configured_puls_type));
+   writer.writeU8(static_cast<uint8_t>(m_current_puls_type));
+   writer.writeU8(static_cast<uint8_t>(m_puls_timeout_status));
+   writer.writeU8(static_cast<uint8_t>(m_puls_debouncing_status));
+   writer.writeTime(m_current_puls_width);
+   writer.writeU32(m_puls_count);
+   writer.writeU32(m_error_count);
+   writer.writeTime(m_puls_timeout);
+   writer.writeTime(m_puls_debounce_time);
+   writer.writeTime(m_timeout_start);
+   writer.writeTime(m_puls_time);
+   writer.writeU8(static_cast<uint8_t>(m_current_edge.m_edge));
+   writer.writeTime(m_current_edge.m_time);
+   writer.writeU8(static_cast<uint8_t>(m_last_edge.m_edge));
+   writer.writeTime(m_last_edge.m_time);
+   writer.writeU8(m_width_filter_shift);
+   writer.writeU8(m_width_filter_samples);
+   writer.writeTime(m_width_filter);
+   writer.writeU8(m_rate_alpha_shift);
+   writer.writeU8(m_rate_beta_shift);
+   writer.writeU8(m_rate_filter_samples);
+   writer.writeTime(m_rate_time);
+   writer.writeTime(m_rate_period);
+}
+
+bool Puls::restoreState(SnapshotReader &reader)
+{
+   /* Restore into a copy, so a rejected snapshot leaves this object unchanged */
+   Puls restored(*this);
+
+   if (!restored.readState(reader))
+   {
+      return false;
+   }
+   *this = restored;
+   return true;
+}
+
+bool Puls::readState(SnapshotReader &reader)
+{
+   EdgeTime_t shift = 0;
+   boolean valid = Edge::restoreState(reader, shift);
+
+   uint8_t configured_type = reader.readU8();
+   uint8_t current_type = reader.readU8();
+   uint8_t timeout_status = reader.readU8();
+   uint8_t debouncing_status = reader.readU8();
+   EdgeTime_t width = reader.readTime();
+   uint32_t count = reader.readU32();
+   uint32_t errors = reader.readU32();
+   EdgeTime_t timeout = reader.readTime();
+   EdgeTime_t debounce_time = reader.readTime();
+   EdgeTime_t timeout_start = reader.readTime();
+   EdgeTime_t puls_time = reader.readTime();
+   uint8_t current_edge = reader.readU8();
+   EdgeTime_t current_edge_time = reader.readTime();
+   uint8_t last_edge = reader.readU8();
+   EdgeTime_t last_edge_time = reader.readTime();
+   uint8_t width_shift = reader.readU8();
+   uint8_t width_samples = reader.readU8();
+   EdgeTime_t width_filter = reader.readTime();
+   uint8_t alpha_shift = reader.readU8();
+   uint8_t beta_shift = reader.readU8();
+   uint8_t rate_samples = reader.readU8();
+   EdgeTime_t rate_time = reader.readTime();
+   EdgeTime_t rate_period = reader.readTime();
+
+   if (!valid || !reader.isValid() ||
+       configured_type > PULS_TIMEOUT || current_type > PULS_TIMEOUT ||
+       timeout_status < PULS_TIMEOUT_DISABLED || timeout_status > PULS_TIMEOUT_ENABLED ||
+       debouncing_status > PULS_DEBOUNCING_ENABLED ||
+       current_edge > EDGE_FALLING || last_edge > EDGE_FALLING ||
+       width_shift >= 8u * sizeof(EdgeTime_t) || width_samples > 1u ||
+       alpha_shift >= 8u * sizeof(EdgeTime_t) || beta_shift >= 8u * sizeof(EdgeTime_t) ||
+       rate_samples > 2u)
+   {
+      DBIF_LOG_WARN("Snapshot invalid");
+      return false;
+   }
+
+   m_puls_resolution = static_cast<PulsResolution_e>(Edge::resolution());
+   m_configured_puls_type = static_cast<PulsType_e>(configured_type);
+   m_current_puls_type = static_cast<PulsType_e>(current_type);
+   m_puls_timeout_status = static_cast<PulsTimeout_e>(timeout_status);
+   m_puls_debouncing_status = static_cast<PulsDebouncing_e>(debouncing_status);
+   m_current_puls_width = width;
+   m_puls_count = count;
+   m_error_count = errors;
+   m_puls_timeout = timeout;
+   m_puls_debounce_time = debounce_time;
+   m_timeout_start = timeout_start;
+   m_puls_time = puls_time + shift;
+   m_current_edge = { static_cast<EdgeType_e>(current_edge), current_edge_time };
+   m_last_edge = { static_cast<EdgeType_e>(last_edge), last_edge_time };
+   m_width_filter_shift = width_shift;
+   m_width_filter_samples = width_samples;
+   m_width_filter = width_filter;
+   m_rate_alpha_shift = alpha_shift;
+   m_rate_beta_shift = beta_shift;
+   m_rate_filter_samples = rate_samples;
+   m_rate_time = rate_time + (shift << PULS_FILTER_FRACTION_BITS);
+   m_rate_period = rate_period;
+
+   /* Move a detection in progress into the current time base */
+   if (m_current_edge.m_edge != EDGE_NO_EDGE)
+      m_current_edge.m_time += shift;
+   if (m_last_edge.m_edge != EDGE_NO_EDGE)
+      m_last_edge.m_time += shift;
+   if (m_current_puls_type == PULS_TRIGGERED_HIGH || m_current_puls_type == PULS_TRIGGERED_LOW)
+      m_timeout_start += shift;
+
+   DBIF_LOG_INFO("Snapshot restored - Count %i", m_puls_count);
+   return true;
+}
+
+EdgeTime_t  Puls::time(void) const
  {
-    if(m_puls_resolution == PULS_RESOLUTION_US)
-      return micros();
-    else 
-      return millis();
+    return Edge::clock(static_cast<EdgeResolution_e>(m_puls_resolution));
  }
 
- void Puls::checkTimeout(uint32_t timeout_time)
+ void Puls::checkTimeout(EdgeTime_t timeout_time)
  {
    /*Do timeout check only when the first edge was detected*/
    if (m_current_puls_type == PULS_TRIGGERED_HIGH ||
@@ -302,11 +501,13 @@ uint32_t  Puls::time(void)
    {
       if(m_puls_timeout_status == PULS_TIMEOUT_ENABLED)
       {
-         if((time() - timeout_time) > (uint32_t)m_puls_timeout)
+         if((EdgeTime_t)(time() - timeout_time) > m_puls_timeout)
          {
             m_current_puls_type = PULS_TIMEOUT;
             m_current_puls_width = PULS_WIDTH_TIME_INVALID;
             m_error_count++;
+            /* The time between the pulses around a timeout is no period */
+            m_rate_filter_samples = 0;
 
             m_last_edge = {
                         .m_edge = EDGE_NO_EDGE,
@@ -324,4 +525,52 @@ void Puls::reset(void)
 {
    m_current_puls_type = PULS_NO_PULS;
    m_current_puls_width = 0;
+}
+
+
+void Puls::updateFilters(void)
+{
+   if(m_width_filter_shift != PULS_FILTER_DISABLED)
+   {
+      /* Saturate instead of overflowing the accumulator */
+      EdgeTime_t limit = static_cast<EdgeTime_t>(~static_cast<EdgeTime_t>(0)) >> m_width_filter_shift;
+      EdgeTime_t width = m_current_puls_width < limit ? m_current_puls_width : limit;
+
+      if(m_width_filter_samples == 0)
+      {
+         /* Start at the first width instead of ramping up from 0 */
+         m_width_filter = width << m_width_filter_shift;
+         m_width_filter_samples = 1;
+      }
+      else
+      {
+         m_width_filter += width - (m_width_filter >> m_width_filter_shift);
+      }
+   }
+
+   if(m_rate_alpha_shift != PULS_FILTER_DISABLED)
+   {
+      /* Times are kept modulo the EdgeTime_t range, only their differences are used */
+      EdgeTime_t measured = m_puls_time << PULS_FILTER_FRACTION_BITS;
+
+      if(m_rate_filter_samples == 0)
+      {
+         m_rate_period = 0;
+         m_rate_filter_samples = 1;
+      }
+      else if(m_rate_filter_samples == 1)
+      {
+         m_rate_period = measured - m_rate_time;
+         m_rate_filter_samples = 2;
+      }
+      else
+      {
+         EdgeTime_t predicted = m_rate_time + m_rate_period;
+         EdgeTimeDiff_t residual = static_cast<EdgeTimeDiff_t>(measured - predicted);
+
+         measured = predicted + static_cast<EdgeTime_t>(residual >> m_rate_alpha_shift);
+         m_rate_period += static_cast<EdgeTime_t>(residual >> m_rate_beta_shift);
+      }
+      m_rate_time = measured;
+   }
 }
\ No newline at end of file
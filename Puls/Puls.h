@@ -13,6 +13,15 @@
 
 #define PULS_WIDTH_TIME_INVALID 0
 #define PULS_DEBOUNCE_DISABLED -1
+#define PULS_FILTER_DISABLED 0u
+
+/**
+ * Fraction bits of the fixed point rate filter state. Periods up to
+ * 2^(bits of EdgeTime_t - PULS_FILTER_FRACTION_BITS - 1) time units are tracked.
+ */
+#ifndef PULS_FILTER_FRACTION_BITS
+#define PULS_FILTER_FRACTION_BITS 4u
+#endif
 
 typedef enum
 {
@@ -56,10 +65,12 @@ public:
     * @brief Puls
     * @param trigger
     */
-   Puls(PulsType_e trigger, uint8_t ioStatus = 0, uint32_t timeout_time = 0, uint32_t debounce_time = 0);
+   Puls(PulsType_e trigger, uint8_t ioStatus = 0, EdgeTime_t timeout_time = 0, EdgeTime_t debounce_time = 0);
 
    Puls(const Puls &) = default;
 
+   Puls &operator=(const Puls &) = default;
+
    /**
     * @brief ~Puls
     */
@@ -77,22 +88,71 @@ public:
 
    PulsType_e getPulsType(void);
 
-   int32_t getPulsWidth(void);
+   /**
+    * @brief getPulsWidth
+    * @return width of the last accepted puls or the running width of a triggered puls
+    */
+   EdgeTimeDiff_t getPulsWidth(void);
 
    uint32_t getPulsCount(void);
 
+   /**
+    * @brief getPulsTime
+    * @return time of the edge which ended the last accepted puls
+    */
+   EdgeTime_t getPulsTime(void);
+
    boolean isErrorOccurred(void);
 
    uint32_t getErrorCount(void);
 
-   void enablePulsTimeout(uint32_t timeout_time);
+   void enablePulsTimeout(EdgeTime_t timeout_time);
 
-   void enableDebounce(uint32_t msDebounce = 500);
+   void enableDebounce(EdgeTime_t msDebounce = 500);
 
    void disablePulsTimeout(void);
 
    void disableDebounce(void);
 
+   EdgeTime_t getDebounceTime(void);
+
+   /**
+    * @brief enableWidthFilter
+    * Smooths the width of the accepted pulses with an integer EMA:
+    * acc += width - (acc >> shift), i.e. alpha = 1 / 2^shift.
+    * The accumulator holds width << shift, so widths are clamped to the
+    * EdgeTime_t range >> shift (e.g. 2^24 - 1 time units with shift 8 in 32 bit mode).
+    * @param shift filter shift, PULS_FILTER_DISABLED disables the filter
+    */
+   void enableWidthFilter(uint8_t shift);
+
+   void disableWidthFilter(void);
+
+   /**
+    * @brief getSmoothedWidth
+    * @return smoothed puls width, 0 before the first accepted puls
+    */
+   EdgeTime_t getSmoothedWidth(void);
+
+   /**
+    * @brief enableRateFilter
+    * Tracks the time between accepted pulses with a fixed point alpha-beta
+    * filter, alpha = 1 / 2^alpha_shift and beta = 1 / 2^beta_shift.
+    * The filter restarts after a puls timeout.
+    * @param alpha_shift time correction shift, PULS_FILTER_DISABLED disables the filter
+    * @param beta_shift period correction shift, usually greater than alpha_shift
+    */
+   void enableRateFilter(uint8_t alpha_shift, uint8_t beta_shift);
+
+   void disableRateFilter(void);
+
+   /**
+    * @brief getSmoothedPeriod
+    * @return smoothed time between accepted pulses, 0 before the second accepted puls.
+    *         The puls rate is 1 / period (e.g. 1000000 / period Hz with microseconds).
+    */
+   EdgeTime_t getSmoothedPeriod(void);
+
    void clear(void);
 
    PulsType_e getTrigger(void);
@@ -101,29 +161,56 @@ public:
 
    PulsResolution_e pulsResolution(void);
 
+   /**
+    * @brief saveState
+    * @param writer
+    */
+   void saveState(SnapshotWriter &writer) const;
+
+   /**
+    * @brief restoreState
+    * @param reader
+    * @return true if the state was valid and has been restored, on false the object is unchanged
+    */
+   bool restoreState(SnapshotReader &reader);
+
 private:
-   void init(PulsType_e trigger, int32_t timeout_time = 0, uint32_t debounce_time = 0, PulsResolution_e resolution = PULS_RESOLUTION_MS);
-   uint32_t time(void);
-   void checkTimeout(uint32_t timeout_time);
+   void init(PulsType_e trigger, EdgeTime_t timeout_time = 0, EdgeTime_t debounce_time = 0, PulsResolution_e resolution = PULS_RESOLUTION_MS);
+   EdgeTime_t time(void) const;
+   void checkTimeout(EdgeTime_t timeout_time);
    void reset(void);
+   void updateFilters(void);
+   bool readState(SnapshotReader &reader);
 
 private:
    PulsType_e m_configured_puls_type;
 
    PulsType_e m_current_puls_type;
-   uint32_t m_current_puls_width;
+   EdgeTime_t m_current_puls_width;
    uint32_t m_puls_count;
    uint32_t m_error_count;
 
-   uint32_t m_puls_timeout;
+   EdgeTime_t m_puls_timeout;
    PulsTimeout_e m_puls_timeout_status;
 
-   uint32_t m_puls_debounce_time;
+   EdgeTime_t m_puls_debounce_time;
    PulsDebouncing_e m_puls_debouncing_status;
    PulsResolution_e m_puls_resolution;
 
    EdgeInfo_t m_current_edge;
    EdgeInfo_t m_last_edge;
+   EdgeTime_t m_timeout_start;
+   EdgeTime_t m_puls_time;
+
+   uint8_t m_width_filter_shift;
+   uint8_t m_width_filter_samples;
+   EdgeTime_t m_width_filter;      /* smoothed width << m_width_filter_shift */
+
+   uint8_t m_rate_alpha_shift;
+   uint8_t m_rate_beta_shift;
+   uint8_t m_rate_filter_samples;
+   EdgeTime_t m_rate_time;         /* estimated puls time, fixed point */
+   EdgeTime_t m_rate_period;       /* estimated period, fixed point */
 };
 
 #endif /*_PULS_H_ */
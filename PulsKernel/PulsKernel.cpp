@@ -0,0 +1,215 @@
+/**
+ * @file PulsKernel.cpp
+ * @brief Implementation file for the PulsKernel class for bulk pulse width calculation.
+ *
+ * This file contains the method implementations for the PulsKernel class, providing
+ * the SIMD width and debounce calculation and the pairing of edges to pulses.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "PulsKernel.h"
+#include "PulsKernel_DebugIf.h"  // For debugging macros
+
+#if defined(PULS_KERNEL_USE_SSE2)
+#include <emmintrin.h>
+#elif defined(PULS_KERNEL_USE_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief Constructor for the PulsKernel class.
+ * @param trigger The pulse trigger as used by Puls.
+ * @param debounce_time Pulses with a width less or equal to this time are rejected.
+ */
+PulsKernel::PulsKernel(PulsType_e trigger, EdgeTime_t debounce_time) :
+   m_trigger(trigger), m_debounce_time(debounce_time)
+{
+   clear();
+}
+
+PulsKernel::PulsKernel(Puls &puls) :
+   m_trigger(puls.getTrigger()), m_debounce_time(puls.getDebounceTime())
+{
+   clear();
+}
+
+PulsKernel::~PulsKernel()
+{
+   // Destructor logic if needed
+}
+
+
+uint16_t PulsKernel::process(const EdgeType_e *edges, const EdgeTime_t *times, uint16_t count, PulsKernelOutput_t &output)
+{
+   EdgeTime_t width[PULS_KERNEL_BLOCK_SIZE];
+   uint16_t i = 0;
+
+   while (i < count)
+   {
+      /* The first edge is related to the last edge of the previous call,
+       * all following blocks to their left neighbour in the array.
+       */
+      uint8_t n = 1u;
+      const EdgeTime_t *previous = &m_last_edge.m_time;
+      if (i > 0)
+      {
+         uint16_t remaining = count - i;
+         n = remaining < PULS_KERNEL_BLOCK_SIZE ? static_cast<uint8_t>(remaining) : PULS_KERNEL_BLOCK_SIZE;
+         previous = &times[i - 1u];
+      }
+
+      uint8_t reject = widths(&times[i], previous, n, width);
+
+      for (uint8_t j = 0; j < n; j++)
+      {
+         uint16_t idx = i + j;
+         EdgeType_e current = edges[idx];
+
+         if (current == EDGE_NO_EDGE)
+         {
+            continue;
+         }
+
+         PulsType_e type = accept(m_last_edge.m_edge, current);
+         if (type == PULS_NO_PULS)
+         {
+            m_last_edge.m_edge = current;
+            m_last_edge.m_time = times[idx];
+            continue;
+         }
+
+         EdgeTime_t w = width[j];
+         bool rejected = (reject & (1u << j)) != 0;
+         if (idx > 0 && edges[idx - 1u] == EDGE_NO_EDGE)
+         {
+            /* Left neighbour was skipped, the SIMD width is not related to the last edge */
+            w = times[idx] - m_last_edge.m_time;
+            rejected = m_debounce_time > 0 && w <= m_debounce_time;
+         }
+
+         if (rejected)
+         {
+            m_reject_count++;
+            DBIF_LOG_WARN("PULS WIDTH DETECTED IN DEBOUNCE TIME");
+         }
+         else if (type == PULS_HIGH)
+         {
+            if (output.m_high_count >= output.m_high_size)
+            {
+               return idx;
+            }
+            output.m_high_width[output.m_high_count] = w;
+            if (output.m_high_time != nullptr)
+               output.m_high_time[output.m_high_count] = times[idx];
+            output.m_high_count++;
+            m_puls_count++;
+         }
+         else
+         {
+            if (output.m_low_count >= output.m_low_size)
+            {
+               return idx;
+            }
+            output.m_low_width[output.m_low_count] = w;
+            if (output.m_low_time != nullptr)
+               output.m_low_time[output.m_low_count] = times[idx];
+            output.m_low_count++;
+            m_puls_count++;
+         }
+
+         /* Same as Puls: the closing edge does not start the next pulse */
+         m_last_edge.m_edge = EDGE_NO_EDGE;
+         m_last_edge.m_time = 0;
+      }
+      i += n;
+   }
+   return count;
+}
+
+
+uint32_t PulsKernel::getPulsCount(void) const
+{
+   return m_puls_count;
+}
+
+
+uint32_t PulsKernel::getRejectCount(void) const
+{
+   return m_reject_count;
+}
+
+
+void PulsKernel::clear(void)
+{
+   m_last_edge.m_edge = EDGE_NO_EDGE;
+   m_last_edge.m_time = 0;
+   m_puls_count = 0;
+   m_reject_count = 0;
+}
+
+
+PulsType_e PulsKernel::accept(EdgeType_e last, EdgeType_e current) const
+{
+   bool high = (last == EDGE_RISING && current == EDGE_FALLING);
+   bool low = (last == EDGE_FALLING && current == EDGE_RISING);
+
+   if (m_trigger == PULS_HIGH)
+   {
+      return high ? PULS_HIGH : PULS_NO_PULS;
+   }
+   else if (m_trigger == PULS_LOW)
+   {
+      return low ? PULS_LOW : PULS_NO_PULS;
+   }
+   return high ? PULS_HIGH : (low ? PULS_LOW : PULS_NO_PULS);
+}
+
+
+uint8_t PulsKernel::widths(const EdgeTime_t *current, const EdgeTime_t *previous, uint8_t count, EdgeTime_t *width) const
+{
+   uint8_t reject = 0;
+   uint8_t j = 0;
+
+#if defined(PULS_KERNEL_USE_SSE2)
+   /* SSE2 has no unsigned compare, flip the sign bit to use the signed one */
+   const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+   const __m128i debounce = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(m_debounce_time)), sign);
+
+   for (; j + 4u <= count; j += 4u)
+   {
+      __m128i w = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(current + j)),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i *>(previous + j)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(width + j), w);
+
+      __m128i accepted = _mm_cmpgt_epi32(_mm_xor_si128(w, sign), debounce);
+      reject |= static_cast<uint8_t>((~_mm_movemask_ps(_mm_castsi128_ps(accepted)) & 0x0F) << j);
+   }
+#elif defined(PULS_KERNEL_USE_NEON)
+   const uint32x4_t debounce = vdupq_n_u32(m_debounce_time);
+   const uint32_t lane_bits[4] = { 1u, 2u, 4u, 8u };
+   const uint32x4_t bits = vld1q_u32(lane_bits);
+
+   for (; j + 4u <= count; j += 4u)
+   {
+      uint32x4_t w = vsubq_u32(vld1q_u32(current + j), vld1q_u32(previous + j));
+      vst1q_u32(width + j, w);
+
+      uint32x4_t rejected = vandq_u32(vcleq_u32(w, debounce), bits);
+      reject |= static_cast<uint8_t>(vaddvq_u32(rejected) << j);
+   }
+#endif
+
+   for (; j < count; j++)
+   {
+      width[j] = current[j] - previous[j];
+      if (width[j] <= m_debounce_time)
+      {
+         reject |= static_cast<uint8_t>(1u << j);
+      }
+   }
+
+   /* Debouncing is disabled with a time of 0, same as Puls::enableDebounce() */
+   return m_debounce_time > 0 ? reject : 0;
+}
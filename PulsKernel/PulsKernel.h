@@ -0,0 +1,124 @@
+/**
+ * @file PulsKernel.h
+ * @brief Header file for the PulsKernel class for bulk pulse width calculation.
+ *
+ * The PulsKernel class converts arrays of edge types and edge timestamps (e.g.
+ * from a capture or an edge queue) into pulse widths in one pass. The widths
+ * of adjacent edges and the debounce mask are calculated with SIMD where the
+ * target supports it (SSE2 or AArch64 NEON), the pairing of the edges and the
+ * compaction by polarity is done afterwards per block.
+ *
+ * The result is the same as feeding the edges one by one into Puls::checkPuls(),
+ * including the debounce rejection. Pulse timeouts depend on the polling time
+ * and are not part of the kernel. With EDGE_TIME_64BIT the widths are calculated
+ * by the scalar path only.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _PULS_KERNEL_H_
+#define _PULS_KERNEL_H_
+
+#include <stdint.h>
+#include "Edge.h"
+#include "Puls.h"
+
+/**
+ * @brief Number of edges processed per block.
+ */
+#define PULS_KERNEL_BLOCK_SIZE 8u
+
+#if !defined(PULS_KERNEL_NO_SIMD) && EDGE_TIME_64BIT == 0
+#if defined(__SSE2__)
+#define PULS_KERNEL_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define PULS_KERNEL_USE_NEON
+#endif
+#endif
+
+/**
+ * @brief Structure describing the output buffers of the kernel.
+ *
+ * The time buffers are optional and may be nullptr. The counts are increased
+ * by the kernel, so the same output can be used for several calls.
+ */
+typedef struct
+{
+   EdgeTime_t *m_high_width; /**< Widths of the accepted high pulses */
+   EdgeTime_t *m_high_time;  /**< End times of the accepted high pulses */
+   uint16_t m_high_size;     /**< Capacity of the high pulse buffers */
+   uint16_t m_high_count;    /**< Number of stored high pulses */
+   EdgeTime_t *m_low_width;  /**< Widths of the accepted low pulses */
+   EdgeTime_t *m_low_time;   /**< End times of the accepted low pulses */
+   uint16_t m_low_size;      /**< Capacity of the low pulse buffers */
+   uint16_t m_low_count;     /**< Number of stored low pulses */
+} PulsKernelOutput_t;
+
+/**
+ * @brief Class calculating pulse widths from edge arrays.
+ */
+class PulsKernel
+{
+public:
+   /**
+    * @brief Constructor for the PulsKernel class.
+    * @param trigger The pulse trigger as used by Puls (PULS_HIGH, PULS_LOW or PULS_BOTH).
+    * @param debounce_time Pulses with a width less or equal to this time are rejected. 0 disables debouncing.
+    */
+   PulsKernel(PulsType_e trigger, EdgeTime_t debounce_time = 0);
+
+   /**
+    * @brief Constructor for the PulsKernel class using the settings of a Puls object.
+    * @param puls The Puls object providing trigger and debounce time.
+    */
+   PulsKernel(Puls &puls);
+
+   /**
+    * @brief Destructor for the PulsKernel class.
+    */
+   virtual ~PulsKernel();
+
+   /**
+    * @brief Processes an array of edges.
+    *
+    * The state is kept between calls, so a long capture can be processed in chunks.
+    * EDGE_NO_EDGE entries are skipped.
+    * @param edges The edge types.
+    * @param times The edge times.
+    * @param count The number of edges.
+    * @param output The output buffers.
+    * @return The number of processed edges. Less than count if an output buffer is full.
+    */
+   uint16_t process(const EdgeType_e *edges, const EdgeTime_t *times, uint16_t count, PulsKernelOutput_t &output);
+
+   /**
+    * @brief Gets the number of accepted pulses.
+    * @return The number of accepted pulses.
+    */
+   uint32_t getPulsCount(void) const;
+
+   /**
+    * @brief Gets the number of pulses rejected by the debounce time.
+    * @return The number of rejected pulses.
+    */
+   uint32_t getRejectCount(void) const;
+
+   /**
+    * @brief Resets the edge state and the counters.
+    */
+   void clear(void);
+
+private:
+   PulsType_e accept(EdgeType_e last, EdgeType_e current) const;
+   uint8_t widths(const EdgeTime_t *current, const EdgeTime_t *previous, uint8_t count, EdgeTime_t *width) const;
+
+private:
+   PulsType_e m_trigger;        /**< Configured pulse trigger */
+   EdgeTime_t m_debounce_time;  /**< Debounce time, 0 if disabled */
+   EdgeInfo_t m_last_edge;      /**< Last edge which was not part of a pulse */
+   uint32_t m_puls_count;       /**< Number of accepted pulses */
+   uint32_t m_reject_count;     /**< Number of rejected pulses */
+};
+
+#endif /* _PULS_KERNEL_H_ */
@@ -0,0 +1,296 @@
+/**
+ * @file PulsPattern.cpp
+ * @brief Implementation file for the PulsPattern classes for matching pulse sequences.
+ *
+ * This file contains the method implementations for the quantisation, the
+ * Aho-Corasick automaton construction and the per-channel matching.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "PulsPattern.h"
+#include "PulsPattern_DebugIf.h"  // For debugging macros
+
+/**
+ * @brief Constructor for the PulsPattern class.
+ */
+PulsPattern::PulsPattern(void) : m_class_count(0), m_pattern_count(0), m_state_count(0), m_compiled(false)
+{
+}
+
+PulsPattern::~PulsPattern()
+{
+   // Destructor logic if needed
+}
+
+
+bool PulsPattern::setClasses(const EdgeTime_t *limits, uint8_t count)
+{
+   if (count == 0 || count > PULS_PATTERN_MAX_CLASSES)
+   {
+      DBIF_LOG_WARN("Width classes invalid = %i", count);
+      return false;
+   }
+   for (uint8_t c = 1; c < count; c++)
+   {
+      if (limits[c] <= limits[c - 1u])
+      {
+         DBIF_LOG_WARN("Width classes not ascending");
+         return false;
+      }
+   }
+
+   for (uint8_t c = 0; c < count; c++)
+   {
+      m_limits[c] = limits[c];
+   }
+   m_class_count = count;
+   return true;
+}
+
+
+int8_t PulsPattern::addPattern(const uint8_t *symbols, uint8_t length)
+{
+   if (m_pattern_count >= PULS_PATTERN_MAX_PATTERNS || m_pattern_count >= 32u ||
+       length == 0 || length > PULS_PATTERN_MAX_LENGTH)
+   {
+      DBIF_LOG_WARN("Pattern invalid - Length %i", length);
+      return PULS_PATTERN_INVALID;
+   }
+   for (uint8_t i = 0; i < length; i++)
+   {
+      if (symbols[i] >= PULS_PATTERN_SYMBOLS)
+      {
+         DBIF_LOG_WARN("Pattern symbol invalid = %i", symbols[i]);
+         return PULS_PATTERN_INVALID;
+      }
+      m_patterns[m_pattern_count][i] = symbols[i];
+   }
+
+   m_lengths[m_pattern_count] = length;
+   m_compiled = false;
+   return static_cast<int8_t>(m_pattern_count++);
+}
+
+
+bool PulsPattern::compile(void)
+{
+   uint8_t fail[PULS_PATTERN_MAX_STATES];
+   uint8_t queue[PULS_PATTERN_MAX_STATES];
+   uint8_t queue_head = 0;
+   uint8_t queue_tail = 0;
+
+   m_compiled = false;
+   m_state_count = 1;
+   for (uint8_t a = 0; a < PULS_PATTERN_SYMBOLS; a++)
+   {
+      m_delta[0][a] = 0;
+   }
+   m_output[0] = 0;
+
+   /* Build the trie. State 0 is the root, so 0 marks a missing child. */
+   for (uint8_t p = 0; p < m_pattern_count; p++)
+   {
+      uint8_t state = 0;
+      for (uint8_t i = 0; i < m_lengths[p]; i++)
+      {
+         uint8_t a = m_patterns[p][i];
+         if (m_delta[state][a] == 0)
+         {
+            if (m_state_count >= PULS_PATTERN_MAX_STATES)
+            {
+               DBIF_LOG_WARN("Pattern automaton too large");
+               return false;
+            }
+            uint8_t next = m_state_count++;
+            for (uint8_t b = 0; b < PULS_PATTERN_SYMBOLS; b++)
+            {
+               m_delta[next][b] = 0;
+            }
+            m_output[next] = 0;
+            m_delta[state][a] = next;
+         }
+         state = m_delta[state][a];
+      }
+      m_output[state] |= (1UL << p);
+   }
+
+   /* Breadth first over the trie: add the failure transitions to the table, so
+    * every state has a follow state for every symbol.
+    */
+   for (uint8_t a = 0; a < PULS_PATTERN_SYMBOLS; a++)
+   {
+      uint8_t child = m_delta[0][a];
+      if (child != 0)
+      {
+         fail[child] = 0;
+         queue[queue_tail++] = child;
+      }
+   }
+   while (queue_head < queue_tail)
+   {
+      uint8_t state = queue[queue_head++];
+      m_output[state] |= m_output[fail[state]];
+
+      for (uint8_t a = 0; a < PULS_PATTERN_SYMBOLS; a++)
+      {
+         uint8_t child = m_delta[state][a];
+         if (child != 0)
+         {
+            fail[child] = m_delta[fail[state]][a];
+            queue[queue_tail++] = child;
+         }
+         else
+         {
+            m_delta[state][a] = m_delta[fail[state]][a];
+         }
+      }
+   }
+
+   m_compiled = true;
+   DBIF_LOG_DEBUG_1("Pattern automaton states = %i", m_state_count);
+   return true;
+}
+
+
+bool PulsPattern::isCompiled(void) const
+{
+   return m_compiled;
+}
+
+
+uint8_t PulsPattern::symbol(PulsType_e type, EdgeTime_t width) const
+{
+   for (uint8_t c = 0; c < m_class_count; c++)
+   {
+      if (width <= m_limits[c])
+      {
+         if (type == PULS_HIGH)
+            return PULS_PATTERN_HIGH(c);
+         else if (type == PULS_LOW)
+            return PULS_PATTERN_LOW(c);
+         break;
+      }
+   }
+   return PULS_PATTERN_NO_SYMBOL;
+}
+
+
+uint8_t PulsPattern::step(uint8_t state, uint8_t symbol) const
+{
+   if (!m_compiled || symbol >= PULS_PATTERN_SYMBOLS || state >= m_state_count)
+   {
+      return 0;
+   }
+   return m_delta[state][symbol];
+}
+
+
+uint32_t PulsPattern::matches(uint8_t state) const
+{
+   return (m_compiled && state < m_state_count) ? m_output[state] : 0;
+}
+
+
+uint8_t PulsPattern::length(uint8_t pattern) const
+{
+   return pattern < m_pattern_count ? m_lengths[pattern] : 0;
+}
+
+
+/**
+ * @brief Constructor for the PulsPatternMatcher class.
+ * @param pattern The compiled patterns.
+ */
+PulsPatternMatcher::PulsPatternMatcher(const PulsPattern &pattern) :
+   m_pattern(pattern), m_puls_count(0), m_error_count(0), m_match_callback(nullptr)
+{
+   reset();
+}
+
+PulsPatternMatcher::~PulsPatternMatcher()
+{
+   // Destructor logic if needed
+}
+
+
+uint32_t PulsPatternMatcher::add(PulsType_e type, EdgeTime_t width, EdgeTime_t end_time)
+{
+   uint8_t symbol = m_pattern.symbol(type, width);
+
+   m_state = m_pattern.step(m_state, symbol);
+   m_starts[m_head] = end_time - width;
+   m_head = (m_head + 1u) % PULS_PATTERN_MAX_LENGTH;
+   m_end = end_time;
+   m_matches = m_pattern.matches(m_state);
+
+   if (m_matches != 0 && m_match_callback != nullptr)
+   {
+      PulsPatternMatch_t match;
+      for (uint8_t p = 0; p < PULS_PATTERN_MAX_PATTERNS; p++)
+      {
+         if (getMatch(p, match))
+         {
+            m_match_callback(this, match);
+         }
+      }
+   }
+   return m_matches;
+}
+
+
+uint32_t PulsPatternMatcher::update(Puls &puls)
+{
+   uint32_t errors = puls.getErrorCount();
+   uint32_t count = puls.getPulsCount();
+
+   if (errors != m_error_count)
+   {
+      m_error_count = errors;
+      reset();
+   }
+   if (count == m_puls_count)
+   {
+      return 0;
+   }
+
+   m_puls_count = count;
+   return add(puls.getPulsType(), static_cast<EdgeTime_t>(puls.getPulsWidth()), puls.getPulsTime());
+}
+
+
+uint32_t PulsPatternMatcher::getMatches(void) const
+{
+   return m_matches;
+}
+
+
+bool PulsPatternMatcher::getMatch(uint8_t pattern, PulsPatternMatch_t &match) const
+{
+   if (pattern >= PULS_PATTERN_MAX_PATTERNS || (m_matches & (1UL << pattern)) == 0)
+   {
+      return false;
+   }
+
+   uint8_t length = m_pattern.length(pattern);
+   match.m_pattern = pattern;
+   match.m_start = m_starts[(m_head + PULS_PATTERN_MAX_LENGTH - length) % PULS_PATTERN_MAX_LENGTH];
+   match.m_end = m_end;
+   return true;
+}
+
+
+void PulsPatternMatcher::setMatchCallback(void (*callback)(PulsPatternMatcher *, const PulsPatternMatch_t &))
+{
+   m_match_callback = callback;
+}
+
+
+void PulsPatternMatcher::reset(void)
+{
+   m_state = 0;
+   m_head = 0;
+   m_end = 0;
+   m_matches = 0;
+}
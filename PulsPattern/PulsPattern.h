@@ -0,0 +1,248 @@
+/**
+ * @file PulsPattern.h
+ * @brief Header file for the PulsPattern classes for matching pulse sequences.
+ *
+ * Accepted pulses are quantised into symbols: the width selects a width class,
+ * the polarity selects the high or the low half of the alphabet. A set of
+ * registered symbol sequences (e.g. blinked fault codes or handshakes) is
+ * compiled into an Aho-Corasick automaton with a complete transition table,
+ * so all patterns are matched with one table lookup per pulse.
+ *
+ * PulsPattern holds the compiled automaton and can be shared by many channels,
+ * PulsPatternMatcher holds the small per-channel state.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _PULS_PATTERN_H_
+#define _PULS_PATTERN_H_
+
+#include <stdint.h>
+#include "Puls.h"
+
+/**
+ * @brief Maximum number of width classes per polarity.
+ */
+#ifndef PULS_PATTERN_MAX_CLASSES
+#define PULS_PATTERN_MAX_CLASSES 4u
+#endif
+
+/**
+ * @brief Maximum number of patterns (at most 32, one bit per pattern).
+ */
+#ifndef PULS_PATTERN_MAX_PATTERNS
+#define PULS_PATTERN_MAX_PATTERNS 8u
+#endif
+
+/**
+ * @brief Maximum length of a pattern in pulses.
+ */
+#ifndef PULS_PATTERN_MAX_LENGTH
+#define PULS_PATTERN_MAX_LENGTH 16u
+#endif
+
+/**
+ * @brief Maximum number of automaton states (at most 255).
+ */
+#ifndef PULS_PATTERN_MAX_STATES
+#define PULS_PATTERN_MAX_STATES 48u
+#endif
+
+/**
+ * @brief Number of symbols of the alphabet.
+ */
+#define PULS_PATTERN_SYMBOLS (2u * PULS_PATTERN_MAX_CLASSES)
+
+/**
+ * @brief Symbol of a high pulse of width class c.
+ */
+#define PULS_PATTERN_HIGH(c) ((uint8_t)(c))
+
+/**
+ * @brief Symbol of a low pulse of width class c.
+ */
+#define PULS_PATTERN_LOW(c) ((uint8_t)(PULS_PATTERN_MAX_CLASSES + (c)))
+
+/**
+ * @brief Symbol of a pulse which is not part of any width class.
+ */
+#define PULS_PATTERN_NO_SYMBOL 0xFFu
+
+/**
+ * @brief Return value for an invalid pattern.
+ */
+#define PULS_PATTERN_INVALID -1
+
+/**
+ * @brief Structure holding one pattern match.
+ */
+typedef struct
+{
+   uint8_t m_pattern;  /**< Index of the matched pattern */
+   EdgeTime_t m_start; /**< Start time of the first pulse of the match */
+   EdgeTime_t m_end;   /**< End time of the last pulse of the match */
+} PulsPatternMatch_t;
+
+/**
+ * @brief Class holding the width classes and the compiled pattern automaton.
+ */
+class PulsPattern
+{
+public:
+   /**
+    * @brief Constructor for the PulsPattern class.
+    */
+   PulsPattern(void);
+
+   /**
+    * @brief Destructor for the PulsPattern class.
+    */
+   virtual ~PulsPattern();
+
+   /**
+    * @brief Sets the width classes, used for both polarities.
+    *
+    * Class c holds the widths up to limits[c] (inclusive) which are above the
+    * previous limit. Wider pulses get PULS_PATTERN_NO_SYMBOL.
+    * @param limits The ascending upper limits of the classes.
+    * @param count The number of classes.
+    * @return true if the classes are valid.
+    */
+   bool setClasses(const EdgeTime_t *limits, uint8_t count);
+
+   /**
+    * @brief Registers a pattern. Invalidates a previous compile().
+    * @param symbols The symbols, see PULS_PATTERN_HIGH() and PULS_PATTERN_LOW().
+    * @param length The number of symbols.
+    * @return The pattern index or PULS_PATTERN_INVALID.
+    */
+   int8_t addPattern(const uint8_t *symbols, uint8_t length);
+
+   /**
+    * @brief Builds the automaton of all registered patterns.
+    * @return true if the automaton fits into PULS_PATTERN_MAX_STATES.
+    */
+   bool compile(void);
+
+   /**
+    * @brief Checks if the automaton is compiled.
+    * @return true after a successful compile().
+    */
+   bool isCompiled(void) const;
+
+   /**
+    * @brief Quantises a pulse.
+    * @param type The pulse type (PULS_HIGH or PULS_LOW).
+    * @param width The pulse width.
+    * @return The symbol or PULS_PATTERN_NO_SYMBOL.
+    */
+   uint8_t symbol(PulsType_e type, EdgeTime_t width) const;
+
+   /**
+    * @brief Gets the follow state of the automaton.
+    * @param state The current state.
+    * @param symbol The next symbol.
+    * @return The follow state. PULS_PATTERN_NO_SYMBOL leads back to the start state.
+    */
+   uint8_t step(uint8_t state, uint8_t symbol) const;
+
+   /**
+    * @brief Gets the patterns ending in a state.
+    * @param state The state.
+    * @return Bit mask of the matched pattern indices.
+    */
+   uint32_t matches(uint8_t state) const;
+
+   /**
+    * @brief Gets the length of a pattern.
+    * @param pattern The pattern index.
+    * @return The number of symbols.
+    */
+   uint8_t length(uint8_t pattern) const;
+
+private:
+   EdgeTime_t m_limits[PULS_PATTERN_MAX_CLASSES];                          /**< Upper width limits of the classes */
+   uint8_t m_class_count;                                                  /**< Number of width classes */
+   uint8_t m_patterns[PULS_PATTERN_MAX_PATTERNS][PULS_PATTERN_MAX_LENGTH]; /**< Registered patterns */
+   uint8_t m_lengths[PULS_PATTERN_MAX_PATTERNS];                           /**< Pattern lengths */
+   uint8_t m_pattern_count;                                                /**< Number of patterns */
+   uint8_t m_delta[PULS_PATTERN_MAX_STATES][PULS_PATTERN_SYMBOLS];         /**< Transition table */
+   uint32_t m_output[PULS_PATTERN_MAX_STATES];                             /**< Matched patterns per state */
+   uint8_t m_state_count;                                                  /**< Number of states */
+   bool m_compiled;                                                        /**< True after compile() */
+};
+
+/**
+ * @brief Class running a compiled PulsPattern over the pulses of one channel.
+ */
+class PulsPatternMatcher
+{
+public:
+   /**
+    * @brief Constructor for the PulsPatternMatcher class.
+    * @param pattern The compiled patterns. Has to outlive the matcher.
+    */
+   PulsPatternMatcher(const PulsPattern &pattern);
+
+   /**
+    * @brief Destructor for the PulsPatternMatcher class.
+    */
+   virtual ~PulsPatternMatcher();
+
+   /**
+    * @brief Adds an accepted pulse.
+    * @param type The pulse type (PULS_HIGH or PULS_LOW).
+    * @param width The pulse width.
+    * @param end_time The time of the edge which ended the pulse.
+    * @return Bit mask of the patterns matched by this pulse.
+    */
+   uint32_t add(PulsType_e type, EdgeTime_t width, EdgeTime_t end_time);
+
+   /**
+    * @brief Adds the last pulse of a Puls object, if it was accepted since the last call.
+    *
+    * Has to be called after every checkPuls(). A pulse timeout breaks the sequence.
+    * @param puls The Puls object.
+    * @return Bit mask of the patterns matched by this pulse.
+    */
+   uint32_t update(Puls &puls);
+
+   /**
+    * @brief Gets the patterns matched by the last pulse.
+    * @return Bit mask of the matched pattern indices.
+    */
+   uint32_t getMatches(void) const;
+
+   /**
+    * @brief Gets a match of the last pulse.
+    * @param pattern The pattern index.
+    * @param match The match with start and end time.
+    * @return true if the pattern was matched by the last pulse.
+    */
+   bool getMatch(uint8_t pattern, PulsPatternMatch_t &match) const;
+
+   /**
+    * @brief Sets a callback which is called for every match.
+    * @param callback The callback function to be set.
+    */
+   void setMatchCallback(void (*callback)(PulsPatternMatcher *, const PulsPatternMatch_t &));
+
+   /**
+    * @brief Restarts the matching, e.g. after a gap in the pulse sequence.
+    */
+   void reset(void);
+
+private:
+   const PulsPattern &m_pattern;                      /**< Compiled patterns */
+   uint8_t m_state;                                   /**< Current automaton state */
+   EdgeTime_t m_starts[PULS_PATTERN_MAX_LENGTH];      /**< Start times of the last pulses */
+   uint8_t m_head;                                    /**< Next index of m_starts */
+   EdgeTime_t m_end;                                  /**< End time of the last pulse */
+   uint32_t m_matches;                                /**< Patterns matched by the last pulse */
+   uint32_t m_puls_count;                             /**< Last seen pulse count of update() */
+   uint32_t m_error_count;                            /**< Last seen error count of update() */
+   void (*m_match_callback)(PulsPatternMatcher *, const PulsPatternMatch_t &); /**< Callback for matches */
+};
+
+#endif /* _PULS_PATTERN_H_ */
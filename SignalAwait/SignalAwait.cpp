@@ -0,0 +1,383 @@
+/**
+ * @file SignalAwait.cpp
+ * @brief Implementation file for the C++20 coroutine interface of Edge and Puls.
+ *
+ * This file contains the method implementations for the scheduler, the waiter
+ * lists and the awaitable Edge and Puls classes.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "SignalAwait.h"
+
+#ifdef SIGNAL_AWAIT_ENABLED
+
+#include <exception>
+#include "SignalAwait_DebugIf.h"  // For debugging macros
+
+void SignalTask::promise_type::unhandled_exception(void)
+{
+   std::terminate();
+}
+
+
+SignalWaiter::SignalWaiter(SignalScheduler &scheduler, EdgeTime_t timeout) :
+   m_scheduler(scheduler), m_handle(), m_timeout(timeout), m_deadline(0), m_timed_out(false), m_closed(false),
+   m_list(nullptr), m_prev(nullptr), m_next(nullptr),
+   m_timer_active(false), m_timer_prev(nullptr), m_timer_next(nullptr), m_ready_next(nullptr)
+{
+}
+
+SignalWaiter::~SignalWaiter()
+{
+   unlink();
+}
+
+bool SignalWaiter::isTimedOut(void) const
+{
+   return m_timed_out;
+}
+
+bool SignalWaiter::isClosed(void) const
+{
+   return m_closed;
+}
+
+SignalAwaitStatus_e SignalWaiter::status(void) const
+{
+   if (m_closed)
+      return SIGNAL_AWAIT_CLOSED;
+   if (m_timed_out)
+      return SIGNAL_AWAIT_TIMEOUT;
+   return SIGNAL_AWAIT_EVENT;
+}
+
+SignalWaiter *SignalWaiter::next(void) const
+{
+   return m_next;
+}
+
+void SignalWaiter::wait(SignalWaiter *&list, std::coroutine_handle<> handle)
+{
+   m_handle = handle;
+   m_list = &list;
+   m_prev = nullptr;
+   m_next = list;
+   if (list != nullptr)
+   {
+      list->m_prev = this;
+   }
+   list = this;
+
+   if (m_timeout != SIGNAL_AWAIT_NO_TIMEOUT)
+   {
+      m_deadline = m_scheduler.time() + m_timeout;
+      m_scheduler.addTimer(this);
+   }
+}
+
+void SignalWaiter::fire(void)
+{
+   if (m_list == nullptr)
+   {
+      return;
+   }
+   unlink();
+   m_scheduler.schedule(this);
+}
+
+void SignalWaiter::cancel(void)
+{
+   m_timed_out = true;
+   fire();
+}
+
+void SignalWaiter::close(void)
+{
+   m_closed = true;
+   fire();
+}
+
+void SignalWaiter::unlink(void)
+{
+   if (m_list != nullptr)
+   {
+      if (m_prev != nullptr)
+         m_prev->m_next = m_next;
+      else
+         *m_list = m_next;
+      if (m_next != nullptr)
+         m_next->m_prev = m_prev;
+
+      m_list = nullptr;
+      m_prev = nullptr;
+      m_next = nullptr;
+   }
+   if (m_timer_active)
+   {
+      m_scheduler.removeTimer(this);
+   }
+}
+
+
+SignalScheduler::SignalScheduler(EdgeResolution_e resolution) :
+   m_resolution(resolution), m_timer_head(nullptr), m_timer_tail(nullptr),
+   m_ready_head(nullptr), m_ready_tail(nullptr)
+{
+}
+
+SignalScheduler::~SignalScheduler()
+{
+   // Destructor logic if needed
+}
+
+uint16_t SignalScheduler::run(void)
+{
+   EdgeTime_t now = time();
+   uint16_t resumed = 0;
+
+   while (m_timer_head != nullptr && static_cast<EdgeTimeDiff_t>(now - m_timer_head->m_deadline) >= 0)
+   {
+      m_timer_head->cancel();
+   }
+
+   /* Take the current list, coroutines firing new events while being resumed
+    * are handled by the next run.
+    */
+   SignalWaiter *waiter = m_ready_head;
+   m_ready_head = nullptr;
+   m_ready_tail = nullptr;
+
+   while (waiter != nullptr)
+   {
+      /* The waiter lives in the coroutine frame and is gone after resume() */
+      SignalWaiter *next = waiter->m_ready_next;
+      std::coroutine_handle<> handle = waiter->m_handle;
+      handle.resume();
+      waiter = next;
+      resumed++;
+   }
+   return resumed;
+}
+
+bool SignalScheduler::nextDeadline(EdgeTime_t &deadline) const
+{
+   if (m_timer_head == nullptr)
+   {
+      return false;
+   }
+   deadline = m_timer_head->m_deadline;
+   return true;
+}
+
+bool SignalScheduler::isReady(void) const
+{
+   return m_ready_head != nullptr;
+}
+
+EdgeTime_t SignalScheduler::time(void) const
+{
+   return Edge::clock(m_resolution);
+}
+
+void SignalScheduler::addTimer(SignalWaiter *waiter)
+{
+   /* Waits mostly use similar timeouts, so the new deadline is usually the
+    * latest one. Searching from the tail keeps the insert O(1) in that case.
+    */
+   SignalWaiter *prev = m_timer_tail;
+   while (prev != nullptr && static_cast<EdgeTimeDiff_t>(waiter->m_deadline - prev->m_deadline) < 0)
+   {
+      prev = prev->m_timer_prev;
+   }
+
+   waiter->m_timer_prev = prev;
+   waiter->m_timer_next = (prev != nullptr) ? prev->m_timer_next : m_timer_head;
+   if (waiter->m_timer_next != nullptr)
+      waiter->m_timer_next->m_timer_prev = waiter;
+   else
+      m_timer_tail = waiter;
+   if (prev != nullptr)
+      prev->m_timer_next = waiter;
+   else
+      m_timer_head = waiter;
+
+   waiter->m_timer_active = true;
+}
+
+void SignalScheduler::removeTimer(SignalWaiter *waiter)
+{
+   if (waiter->m_timer_prev != nullptr)
+      waiter->m_timer_prev->m_timer_next = waiter->m_timer_next;
+   else
+      m_timer_head = waiter->m_timer_next;
+   if (waiter->m_timer_next != nullptr)
+      waiter->m_timer_next->m_timer_prev = waiter->m_timer_prev;
+   else
+      m_timer_tail = waiter->m_timer_prev;
+
+   waiter->m_timer_prev = nullptr;
+   waiter->m_timer_next = nullptr;
+   waiter->m_timer_active = false;
+}
+
+void SignalScheduler::schedule(SignalWaiter *waiter)
+{
+   waiter->m_ready_next = nullptr;
+   if (m_ready_tail != nullptr)
+      m_ready_tail->m_ready_next = waiter;
+   else
+      m_ready_head = waiter;
+   m_ready_tail = waiter;
+}
+
+
+EdgeAwaiter::EdgeAwaiter(AwaitEdge &edge, EdgeType_e type, EdgeTime_t timeout) :
+   SignalWaiter(edge.m_scheduler, timeout), m_edge(edge), m_type(type)
+{
+   m_info.m_edge = EDGE_NO_EDGE;
+   m_info.m_time = 0;
+}
+
+void EdgeAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+   wait(m_edge.m_waiters, handle);
+}
+
+EdgeEvent_t EdgeAwaiter::await_resume(void) const
+{
+   EdgeEvent_t edge_event;
+   edge_event.m_edge = m_info.m_edge;
+   edge_event.m_time = m_info.m_time;
+   edge_event.m_status = status();
+   return edge_event;
+}
+
+bool EdgeAwaiter::accepts(EdgeType_e edge) const
+{
+   return m_type == EDGE_NO_EDGE || m_type == edge;
+}
+
+void EdgeAwaiter::deliver(EdgeInfo_t info)
+{
+   m_info = info;
+   fire();
+}
+
+
+PulsAwaiter::PulsAwaiter(AwaitPuls &puls, EdgeTime_t timeout) :
+   SignalWaiter(puls.m_scheduler, timeout), m_puls(puls)
+{
+   m_result.m_type = PULS_NO_PULS;
+   m_result.m_width = 0;
+   m_result.m_count = 0;
+   m_result.m_status = SIGNAL_AWAIT_EVENT;
+}
+
+void PulsAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+   wait(m_puls.m_waiters, handle);
+}
+
+PulsEvent_t PulsAwaiter::await_resume(void) const
+{
+   PulsEvent_t puls_event = m_result;
+   puls_event.m_status = status();
+   return puls_event;
+}
+
+void PulsAwaiter::deliver(PulsEvent_t puls_event)
+{
+   m_result = puls_event;
+   fire();
+}
+
+
+AwaitEdge::AwaitEdge(SignalScheduler &scheduler, uint8_t io_status, EdgeResolution_e resolution) :
+   Edge(io_status, resolution), m_scheduler(scheduler), m_waiters(nullptr)
+{
+}
+
+AwaitEdge::~AwaitEdge()
+{
+   while (m_waiters != nullptr)
+   {
+      m_waiters->close();
+   }
+}
+
+void AwaitEdge::checkEdges(void)
+{
+   Edge::checkEdges();
+
+   EdgeInfo_t edge = Edge::info();
+   if (edge.m_edge == EDGE_NO_EDGE)
+   {
+      return;
+   }
+
+   SignalWaiter *waiter = m_waiters;
+   while (waiter != nullptr)
+   {
+      EdgeAwaiter *edge_waiter = static_cast<EdgeAwaiter *>(waiter);
+      waiter = waiter->next();
+      if (edge_waiter->accepts(edge.m_edge))
+      {
+         edge_waiter->deliver(edge);
+      }
+   }
+}
+
+EdgeAwaiter AwaitEdge::nextEdge(EdgeType_e type, EdgeTime_t timeout)
+{
+   return EdgeAwaiter(*this, type, timeout);
+}
+
+
+AwaitPuls::AwaitPuls(SignalScheduler &scheduler, PulsType_e trigger, uint8_t ioStatus,
+                     EdgeTime_t timeout_time, EdgeTime_t debounce_time) :
+   Puls(trigger, ioStatus, timeout_time, debounce_time), m_scheduler(scheduler), m_waiters(nullptr)
+{
+}
+
+AwaitPuls::~AwaitPuls()
+{
+   while (m_waiters != nullptr)
+   {
+      m_waiters->close();
+   }
+}
+
+void AwaitPuls::checkPuls(uint8_t pinStatus)
+{
+   uint32_t count = getPulsCount();
+   uint32_t errors = getErrorCount();
+
+   Puls::checkPuls(pinStatus);
+
+   if (m_waiters == nullptr || (count == getPulsCount() && errors == getErrorCount()))
+   {
+      return;
+   }
+
+   PulsEvent_t puls_event;
+   puls_event.m_type = getPulsType();
+   puls_event.m_width = getPulsWidth();
+   puls_event.m_count = getPulsCount();
+   puls_event.m_status = SIGNAL_AWAIT_EVENT;
+
+   DBIF_LOG_DEBUG_1("Resume waiters - Count %i", puls_event.m_count);
+
+   while (m_waiters != nullptr)
+   {
+      static_cast<PulsAwaiter *>(m_waiters)->deliver(puls_event);
+   }
+}
+
+PulsAwaiter AwaitPuls::nextPulse(EdgeTime_t timeout)
+{
+   return PulsAwaiter(*this, timeout);
+}
+
+#endif /* SIGNAL_AWAIT_ENABLED */
@@ -0,0 +1,411 @@
+/**
+ * @file SignalAwait.h
+ * @brief Header file for the C++20 coroutine interface of Edge and Puls.
+ *
+ * Instead of polling Puls::checkPuls() until a pulse arrives, a coroutine can
+ * suspend on the next pulse or edge:
+ *
+ *    SignalTask consumer(AwaitPuls &puls)
+ *    {
+ *       for (;;)
+ *       {
+ *          PulsEvent_t puls_event = co_await puls.nextPulse(100);
+ *          if (puls_event.m_status == SIGNAL_AWAIT_CLOSED)
+ *          {
+ *             co_return;  // puls is destroyed, it must not be used any more
+ *          }
+ *          ...
+ *       }
+ *    }
+ *
+ * Waiting coroutines are kept in intrusive lists of their source, so they cost
+ * nothing until the detection call (checkPuls() / checkEdges()) of the source
+ * reports their event. The single threaded SignalScheduler resumes them and
+ * handles the optional timeouts.
+ *
+ * The interface is only available when the compiler supports coroutines
+ * (C++20, e.g. host builds on Linux). It is empty on other targets.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _SIGNAL_AWAIT_H_
+#define _SIGNAL_AWAIT_H_
+
+#if defined(__has_include)
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#define SIGNAL_AWAIT_ENABLED
+#endif
+#endif
+
+#ifdef SIGNAL_AWAIT_ENABLED
+
+#include <stdint.h>
+#include <coroutine>
+#include "Edge.h"
+#include "Puls.h"
+
+class SignalScheduler;
+class AwaitEdge;
+class AwaitPuls;
+
+/**
+ * @brief Value of a disabled wait timeout.
+ */
+#define SIGNAL_AWAIT_NO_TIMEOUT 0u
+
+/**
+ * @brief Enumeration for the end of a wait.
+ */
+typedef enum
+{
+   SIGNAL_AWAIT_EVENT = 0, /**< The awaited event was detected */
+   SIGNAL_AWAIT_TIMEOUT,   /**< The wait timeout elapsed */
+   SIGNAL_AWAIT_CLOSED     /**< The source was destroyed, it must not be used any more */
+} SignalAwaitStatus_e;
+
+/**
+ * @brief Structure holding the result of an edge wait.
+ */
+typedef struct
+{
+   EdgeType_e m_edge;            /**< Type of the detected edge, EDGE_NO_EDGE if the wait ended without edge */
+   EdgeTime_t m_time;            /**< Time at which the edge was detected */
+   SignalAwaitStatus_e m_status; /**< End of the wait */
+} EdgeEvent_t;
+
+/**
+ * @brief Structure holding the result of a pulse wait.
+ */
+typedef struct
+{
+   PulsType_e m_type;            /**< PULS_HIGH / PULS_LOW, PULS_TIMEOUT on a pulse timeout, PULS_NO_PULS if the wait ended without pulse */
+   EdgeTimeDiff_t m_width;       /**< Width of the pulse */
+   uint32_t m_count;             /**< Pulse count after the event */
+   SignalAwaitStatus_e m_status; /**< End of the wait */
+} PulsEvent_t;
+
+/**
+ * @brief Return type of a fire and forget coroutine.
+ *
+ * The coroutine starts immediately and releases its frame when it returns.
+ */
+class SignalTask
+{
+public:
+   struct promise_type
+   {
+      SignalTask get_return_object(void) { return SignalTask(); }
+      std::suspend_never initial_suspend(void) noexcept { return {}; }
+      std::suspend_never final_suspend(void) noexcept { return {}; }
+      void return_void(void) {}
+      void unhandled_exception(void);
+   };
+};
+
+/**
+ * @brief Base class of all awaitable objects.
+ *
+ * A waiter is linked into the list of its source and, with a timeout, into the
+ * timer list of the scheduler. It lives in the frame of the waiting coroutine.
+ */
+class SignalWaiter
+{
+public:
+   /**
+    * @brief Constructor for the SignalWaiter class.
+    * @param scheduler The scheduler resuming the coroutine.
+    * @param timeout The wait timeout in scheduler time, SIGNAL_AWAIT_NO_TIMEOUT to wait forever.
+    */
+   SignalWaiter(SignalScheduler &scheduler, EdgeTime_t timeout);
+
+   SignalWaiter(const SignalWaiter &) = delete;
+   SignalWaiter &operator=(const SignalWaiter &) = delete;
+
+   /**
+    * @brief Destructor for the SignalWaiter class. Unlinks a pending waiter.
+    */
+   virtual ~SignalWaiter();
+
+   bool await_ready(void) const noexcept { return false; }
+
+   /**
+    * @brief Checks if the wait ended by its timeout.
+    * @return true if the timeout elapsed before the event.
+    */
+   bool isTimedOut(void) const;
+
+   /**
+    * @brief Checks if the wait ended by the destruction of its source.
+    * @return true if the source is gone.
+    */
+   bool isClosed(void) const;
+
+   /**
+    * @brief Gets the next waiter of the same source.
+    * @return The next waiter or nullptr.
+    */
+   SignalWaiter *next(void) const;
+
+   /**
+    * @brief Removes the waiter from its source and hands it to the scheduler.
+    */
+   void fire(void);
+
+   /**
+    * @brief Ends the wait as timed out and hands the waiter to the scheduler.
+    */
+   void cancel(void);
+
+   /**
+    * @brief Ends the wait as closed and hands the waiter to the scheduler.
+    */
+   void close(void);
+
+protected:
+   /**
+    * @brief Gets the end of the wait.
+    * @return SIGNAL_AWAIT_TIMEOUT / SIGNAL_AWAIT_CLOSED, otherwise SIGNAL_AWAIT_EVENT.
+    */
+   SignalAwaitStatus_e status(void) const;
+
+   /**
+    * @brief Links the waiter into the list of its source.
+    * @param list The waiter list of the source.
+    * @param handle The suspended coroutine.
+    */
+   void wait(SignalWaiter *&list, std::coroutine_handle<> handle);
+
+private:
+   friend class SignalScheduler;
+
+   void unlink(void);
+
+private:
+   SignalScheduler &m_scheduler;    /**< Scheduler resuming the coroutine */
+   std::coroutine_handle<> m_handle; /**< Suspended coroutine */
+   EdgeTime_t m_timeout;            /**< Wait timeout */
+   EdgeTime_t m_deadline;           /**< Time at which the wait times out */
+   bool m_timed_out;                /**< True if the timeout elapsed */
+   bool m_closed;                   /**< True if the source was destroyed */
+   SignalWaiter **m_list;           /**< Waiter list of the source or nullptr */
+   SignalWaiter *m_prev;            /**< Previous waiter of the source */
+   SignalWaiter *m_next;            /**< Next waiter of the source */
+   bool m_timer_active;             /**< True while linked into the timer list */
+   SignalWaiter *m_timer_prev;      /**< Previous waiter of the timer list */
+   SignalWaiter *m_timer_next;      /**< Next waiter of the timer list */
+   SignalWaiter *m_ready_next;      /**< Next waiter of the ready list */
+};
+
+/**
+ * @brief Single threaded scheduler resuming waiting coroutines.
+ */
+class SignalScheduler
+{
+public:
+   /**
+    * @brief Constructor for the SignalScheduler class.
+    * @param resolution The time base of the wait timeouts.
+    */
+   SignalScheduler(EdgeResolution_e resolution = EDGE_RESOLUTION_MS);
+
+   /**
+    * @brief Destructor for the SignalScheduler class.
+    */
+   virtual ~SignalScheduler();
+
+   /**
+    * @brief Handles elapsed timeouts and resumes all coroutines whose event has fired.
+    * @return The number of resumed coroutines.
+    */
+   uint16_t run(void);
+
+   /**
+    * @brief Gets the earliest pending timeout, e.g. to sleep until then.
+    * @param deadline The time of the earliest timeout.
+    * @return true if a timeout is pending.
+    */
+   bool nextDeadline(EdgeTime_t &deadline) const;
+
+   /**
+    * @brief Checks if coroutines are ready to be resumed.
+    * @return true if run() would resume a coroutine.
+    */
+   bool isReady(void) const;
+
+   /**
+    * @brief Gets the current scheduler time.
+    * @return The time in microseconds or milliseconds.
+    */
+   EdgeTime_t time(void) const;
+
+private:
+   friend class SignalWaiter;
+
+   void addTimer(SignalWaiter *waiter);
+   void removeTimer(SignalWaiter *waiter);
+   void schedule(SignalWaiter *waiter);
+
+private:
+   EdgeResolution_e m_resolution; /**< Time base of the timeouts */
+   SignalWaiter *m_timer_head;    /**< Timer list, sorted by deadline */
+   SignalWaiter *m_timer_tail;    /**< Last entry of the timer list */
+   SignalWaiter *m_ready_head;    /**< Waiters to be resumed */
+   SignalWaiter *m_ready_tail;    /**< Last entry of the ready list */
+};
+
+/**
+ * @brief Awaitable object returned by AwaitEdge::nextEdge().
+ */
+class EdgeAwaiter : public SignalWaiter
+{
+public:
+   EdgeAwaiter(AwaitEdge &edge, EdgeType_e type, EdgeTime_t timeout);
+
+   void await_suspend(std::coroutine_handle<> handle);
+
+   /**
+    * @brief Gets the result of the wait.
+    * @return The edge event. m_status tells a timeout or a destroyed source.
+    */
+   EdgeEvent_t await_resume(void) const;
+
+   /**
+    * @brief Checks if an edge is the awaited one.
+    * @param edge The detected edge type.
+    * @return true if the waiter accepts the edge.
+    */
+   bool accepts(EdgeType_e edge) const;
+
+   /**
+    * @brief Stores the detected edge and fires the waiter.
+    * @param info The edge information.
+    */
+   void deliver(EdgeInfo_t info);
+
+private:
+   AwaitEdge &m_edge;     /**< Edge source */
+   EdgeType_e m_type;     /**< Awaited edge type, EDGE_NO_EDGE for any */
+   EdgeInfo_t m_info;     /**< Detected edge */
+};
+
+/**
+ * @brief Awaitable object returned by AwaitPuls::nextPulse().
+ */
+class PulsAwaiter : public SignalWaiter
+{
+public:
+   PulsAwaiter(AwaitPuls &puls, EdgeTime_t timeout);
+
+   void await_suspend(std::coroutine_handle<> handle);
+
+   /**
+    * @brief Gets the result of the wait.
+    * @return The pulse event. m_status tells a timeout or a destroyed source.
+    */
+   PulsEvent_t await_resume(void) const;
+
+   /**
+    * @brief Stores the detected pulse and fires the waiter.
+    * @param puls_event The pulse event.
+    */
+   void deliver(PulsEvent_t puls_event);
+
+private:
+   AwaitPuls &m_puls;     /**< Pulse source */
+   PulsEvent_t m_result;  /**< Detected pulse */
+};
+
+/**
+ * @brief Edge detection with awaitable edges.
+ *
+ * checkEdges() hides Edge::checkEdges() and has to be called on this type.
+ */
+class AwaitEdge : public Edge
+{
+public:
+   /**
+    * @brief Constructor for the AwaitEdge class.
+    * @param scheduler The scheduler resuming the waiting coroutines.
+    * @param io_status The initial level of the digital input/output.
+    * @param resolution The resolution of the edge occurrence time.
+    */
+   AwaitEdge(SignalScheduler &scheduler, uint8_t io_status = 0, EdgeResolution_e resolution = EDGE_RESOLUTION_MS);
+
+   AwaitEdge(const AwaitEdge &) = delete;
+
+   /**
+    * @brief Destructor for the AwaitEdge class. Pending waits end with SIGNAL_AWAIT_CLOSED.
+    */
+   virtual ~AwaitEdge();
+
+   /**
+    * @brief Checks for edges and fires the waiters of a detected edge.
+    */
+   void checkEdges(void);
+
+   /**
+    * @brief Waits for the next edge.
+    * @param type The awaited edge type, EDGE_NO_EDGE for any edge.
+    * @param timeout The wait timeout in scheduler time, SIGNAL_AWAIT_NO_TIMEOUT to wait forever.
+    * @return The awaitable object.
+    */
+   EdgeAwaiter nextEdge(EdgeType_e type = EDGE_NO_EDGE, EdgeTime_t timeout = SIGNAL_AWAIT_NO_TIMEOUT);
+
+private:
+   friend class EdgeAwaiter;
+
+   SignalScheduler &m_scheduler; /**< Scheduler of the waiters */
+   SignalWaiter *m_waiters;      /**< Waiting coroutines */
+};
+
+/**
+ * @brief Pulse detection with awaitable pulses.
+ *
+ * checkPuls() hides Puls::checkPuls() and has to be called on this type.
+ */
+class AwaitPuls : public Puls
+{
+public:
+   /**
+    * @brief Constructor for the AwaitPuls class.
+    * @param scheduler The scheduler resuming the waiting coroutines.
+    * @param trigger The pulse trigger.
+    * @param ioStatus The initial level of the digital input/output.
+    * @param timeout_time The pulse timeout.
+    * @param debounce_time The debounce time.
+    */
+   AwaitPuls(SignalScheduler &scheduler, PulsType_e trigger, uint8_t ioStatus = 0,
+             EdgeTime_t timeout_time = 0, EdgeTime_t debounce_time = 0);
+
+   AwaitPuls(const AwaitPuls &) = delete;
+
+   /**
+    * @brief Destructor for the AwaitPuls class. Pending waits end with SIGNAL_AWAIT_CLOSED.
+    */
+   virtual ~AwaitPuls();
+
+   /**
+    * @brief Checks for pulses and fires the waiters of an accepted pulse or a pulse timeout.
+    * @param pinStatus The current input level.
+    */
+   void checkPuls(uint8_t pinStatus);
+
+   /**
+    * @brief Waits for the next accepted pulse or pulse timeout.
+    * @param timeout The wait timeout in scheduler time, SIGNAL_AWAIT_NO_TIMEOUT to wait forever.
+    * @return The awaitable object.
+    */
+   PulsAwaiter nextPulse(EdgeTime_t timeout = SIGNAL_AWAIT_NO_TIMEOUT);
+
+private:
+   friend class PulsAwaiter;
+
+   SignalScheduler &m_scheduler; /**< Scheduler of the waiters */
+   SignalWaiter *m_waiters;      /**< Waiting coroutines */
+};
+
+#endif /* SIGNAL_AWAIT_ENABLED */
+
+#endif /* _SIGNAL_AWAIT_H_ */
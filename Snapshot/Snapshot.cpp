@@ -0,0 +1,171 @@
+/**
+ * @file Snapshot.cpp
+ * @brief Implementation file for the Snapshot class for saving and restoring detector state.
+ *
+ * This file contains the method implementations for the Snapshot class.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "Snapshot.h"
+#include "Snapshot_DebugIf.h"  // For debugging macros
+
+/**
+ * @brief Type byte flag matching the time base of this build.
+ */
+#if EDGE_TIME_64BIT == 1
+#define SNAPSHOT_TIME_FLAG SNAPSHOT_TYPE_TIME64
+#else
+#define SNAPSHOT_TIME_FLAG 0u
+#endif
+
+/**
+ * @brief Nibble table for CRC-16/CCITT (polynomial 0x1021). Keeps the table
+ * at 32 bytes while needing only two lookups per byte.
+ */
+static const uint16_t s_crc16_table[16] =
+{
+   0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+   0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+
+
+uint16_t Snapshot::size(const Edge *, uint16_t count)
+{
+   return imageSize(count, SNAPSHOT_EDGE_SIZE);
+}
+
+uint16_t Snapshot::size(const Puls *, uint16_t count)
+{
+   return imageSize(count, SNAPSHOT_PULS_SIZE);
+}
+
+uint16_t Snapshot::save(const Edge *bank, uint16_t count, uint8_t *buffer, uint16_t size)
+{
+   return saveBank(bank, count, SNAPSHOT_TYPE_EDGE, SNAPSHOT_EDGE_SIZE, buffer, size);
+}
+
+uint16_t Snapshot::save(const Puls *bank, uint16_t count, uint8_t *buffer, uint16_t size)
+{
+   return saveBank(bank, count, SNAPSHOT_TYPE_PULS, SNAPSHOT_PULS_SIZE, buffer, size);
+}
+
+bool Snapshot::restore(Edge *bank, uint16_t count, const uint8_t *buffer, uint16_t size)
+{
+   return restoreBank(bank, count, SNAPSHOT_TYPE_EDGE, SNAPSHOT_EDGE_SIZE, buffer, size);
+}
+
+bool Snapshot::restore(Puls *bank, uint16_t count, const uint8_t *buffer, uint16_t size)
+{
+   return restoreBank(bank, count, SNAPSHOT_TYPE_PULS, SNAPSHOT_PULS_SIZE, buffer, size);
+}
+
+
+uint16_t Snapshot::crc16(const uint8_t *data, uint16_t length, uint16_t crc)
+{
+   for (uint16_t i = 0; i < length; i++)
+   {
+      crc = static_cast<uint16_t>((crc << 4) ^ s_crc16_table[(crc >> 12) ^ (data[i] >> 4)]);
+      crc = static_cast<uint16_t>((crc << 4) ^ s_crc16_table[(crc >> 12) ^ (data[i] & 0x0Fu)]);
+   }
+   return crc;
+}
+
+
+uint16_t Snapshot::imageSize(uint16_t count, uint16_t object_size)
+{
+   uint32_t size = SNAPSHOT_HEADER_SIZE + static_cast<uint32_t>(count) * object_size + SNAPSHOT_CRC_SIZE;
+
+   /* Buffer sizes are 16 bit, a larger image can not be saved at all */
+   return (size > 0xFFFFu) ? 0 : static_cast<uint16_t>(size);
+}
+
+
+template <typename T>
+uint16_t Snapshot::saveBank(const T *bank, uint16_t count, SnapshotType_e type,
+                            uint16_t object_size, uint8_t *buffer, uint16_t size)
+{
+   uint32_t payload = static_cast<uint32_t>(count) * object_size;
+
+   if (bank == nullptr || buffer == nullptr ||
+       SNAPSHOT_HEADER_SIZE + payload + SNAPSHOT_CRC_SIZE > size)
+   {
+      DBIF_LOG_WARN("Snapshot buffer too small = %i", size);
+      return 0;
+   }
+
+   SnapshotWriter writer(buffer, size);
+   writer.writeU16(SNAPSHOT_MAGIC);
+   writer.writeU8(SNAPSHOT_VERSION);
+   writer.writeU8(static_cast<uint8_t>(type | SNAPSHOT_TIME_FLAG));
+   writer.writeU16(count);
+   writer.writeU16(static_cast<uint16_t>(payload));
+
+   for (uint16_t i = 0; i < count; i++)
+   {
+      bank[i].saveState(writer);
+   }
+
+   writer.writeU16(crc16(buffer, writer.length()));
+
+   DBIF_LOG_DEBUG_1("Snapshot saved = %i bytes", writer.length());
+   return writer.isValid() ? writer.length() : 0;
+}
+
+
+template <typename T>
+bool Snapshot::restoreBank(T *bank, uint16_t count, SnapshotType_e type,
+                           uint16_t object_size, const uint8_t *buffer, uint16_t size)
+{
+   if (bank == nullptr || buffer == nullptr || size < SNAPSHOT_HEADER_SIZE + SNAPSHOT_CRC_SIZE)
+   {
+      return false;
+   }
+
+   SnapshotReader header(buffer, SNAPSHOT_HEADER_SIZE);
+   uint16_t magic = header.readU16();
+   uint8_t version = header.readU8();
+   uint8_t saved_type = header.readU8();
+   uint16_t saved_count = header.readU16();
+   uint16_t payload = header.readU16();
+
+   if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || saved_type != (type | SNAPSHOT_TIME_FLAG) ||
+       saved_count != count || payload != static_cast<uint32_t>(count) * object_size ||
+       SNAPSHOT_HEADER_SIZE + payload + SNAPSHOT_CRC_SIZE > size)
+   {
+      DBIF_LOG_WARN("Snapshot header invalid - Version %i", version);
+      return false;
+   }
+
+   uint16_t length = SNAPSHOT_HEADER_SIZE + payload;
+   SnapshotReader trailer(buffer + length, SNAPSHOT_CRC_SIZE);
+   if (trailer.readU16() != crc16(buffer, length))
+   {
+      DBIF_LOG_WARN("Snapshot CRC invalid");
+      return false;
+   }
+
+   /* Validate every object on a copy first, so a rejected image leaves the
+    * whole bank unchanged.
+    */
+   SnapshotReader check(buffer + SNAPSHOT_HEADER_SIZE, payload);
+   for (uint16_t i = 0; i < count; i++)
+   {
+      T scratch(bank[i]);
+      if (!scratch.restoreState(check))
+      {
+         DBIF_LOG_WARN("Snapshot object invalid = %i", i);
+         return false;
+      }
+   }
+
+   SnapshotReader reader(buffer + SNAPSHOT_HEADER_SIZE, payload);
+   for (uint16_t i = 0; i < count; i++)
+   {
+      bank[i].restoreState(reader);
+   }
+
+   DBIF_LOG_DEBUG_1("Snapshot restored = %i objects", count);
+   return true;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file Snapshot.h
+ * @brief Header file for the Snapshot class for saving and restoring detector state.
+ *
+ * The Snapshot class writes the complete state of Edge and Puls objects into a
+ * compact binary image and restores it again, e.g. after a watchdog reset or a
+ * process restart. An image holds one or more objects of the same type (a bank)
+ * and is protected by a header with a version and a CRC.
+ *
+ * Image layout (little endian):
+ *   magic (2) | version (1) | type (1) | count (2) | payload length (2) | payload | crc16 (2)
+ *
+ * Timestamps of a detection in progress are rebased on restore, so the time
+ * between saving and restoring does not count into the pulse width or timeout.
+ * Timestamps take SNAPSHOT_TIME_SIZE bytes, so images of a 64 bit time base
+ * (EDGE_TIME_64BIT) are marked in the type byte and rejected by 32 bit builds.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+#include <stdint.h>
+#include "Edge.h"
+#include "Puls.h"
+#include "SnapshotStream.h"
+
+/**
+ * @brief Magic number at the start of every snapshot image ("SA").
+ */
+#define SNAPSHOT_MAGIC 0x4153u
+
+/**
+ * @brief Version of the snapshot layout. Increase it on every layout change.
+ */
+#define SNAPSHOT_VERSION 4u
+
+/**
+ * @brief Size of the image header in bytes.
+ */
+#define SNAPSHOT_HEADER_SIZE 8u
+
+/**
+ * @brief Size of the CRC at the end of the image in bytes.
+ */
+#define SNAPSHOT_CRC_SIZE 2u
+
+/**
+ * @brief Flag in the type byte of images holding 64 bit timestamps.
+ */
+#define SNAPSHOT_TYPE_TIME64 0x80u
+
+/**
+ * @brief Size of the state of one Edge object in bytes.
+ */
+#define SNAPSHOT_EDGE_SIZE (4u + 2u * SNAPSHOT_TIME_SIZE)
+
+/**
+ * @brief Size of the state of one Puls object in bytes.
+ */
+#define SNAPSHOT_PULS_SIZE (SNAPSHOT_EDGE_SIZE + 19u + 10u * SNAPSHOT_TIME_SIZE)
+
+/**
+ * @brief Enumeration for the object type stored in an image.
+ */
+typedef enum
+{
+   SNAPSHOT_TYPE_EDGE = 1, /**< Image holds Edge objects */
+   SNAPSHOT_TYPE_PULS = 2  /**< Image holds Puls objects */
+} SnapshotType_e;
+
+/**
+ * @brief Class saving and restoring the state of Edge and Puls banks.
+ */
+class Snapshot
+{
+public:
+   /**
+    * @brief Gets the image size for a bank of Edge objects.
+    * @param count The number of objects.
+    * @return The required buffer size in bytes, 0 if the image exceeds 65535 bytes.
+    */
+   static uint16_t size(const Edge *bank, uint16_t count);
+
+   /**
+    * @brief Gets the image size for a bank of Puls objects.
+    * @param count The number of objects.
+    * @return The required buffer size in bytes, 0 if the image exceeds 65535 bytes.
+    */
+   static uint16_t size(const Puls *bank, uint16_t count);
+
+   /**
+    * @brief Saves a bank of Edge objects.
+    * @param bank The objects to be saved. A single object is a bank with count 1.
+    * @param count The number of objects.
+    * @param buffer The destination buffer.
+    * @param size The size of the destination buffer.
+    * @return The number of written bytes or 0 if the buffer is too small.
+    */
+   static uint16_t save(const Edge *bank, uint16_t count, uint8_t *buffer, uint16_t size);
+
+   /**
+    * @brief Saves a bank of Puls objects.
+    * @param bank The objects to be saved. A single object is a bank with count 1.
+    * @param count The number of objects.
+    * @param buffer The destination buffer.
+    * @param size The size of the destination buffer.
+    * @return The number of written bytes or 0 if the buffer is too small.
+    */
+   static uint16_t save(const Puls *bank, uint16_t count, uint8_t *buffer, uint16_t size);
+
+   /**
+    * @brief Restores a bank of Edge objects.
+    * @param bank The objects to be restored.
+    * @param count The number of objects. Has to match the saved count.
+    * @param buffer The image.
+    * @param size The size of the image.
+    * @return true if the image was valid and all objects have been restored. On false no object is changed.
+    */
+   static bool restore(Edge *bank, uint16_t count, const uint8_t *buffer, uint16_t size);
+
+   /**
+    * @brief Restores a bank of Puls objects.
+    * @param bank The objects to be restored.
+    * @param count The number of objects. Has to match the saved count.
+    * @param buffer The image.
+    * @param size The size of the image.
+    * @return true if the image was valid and all objects have been restored. On false no object is changed.
+    */
+   static bool restore(Puls *bank, uint16_t count, const uint8_t *buffer, uint16_t size);
+
+   /**
+    * @brief Calculates the CRC-16/CCITT-FALSE of a buffer.
+    * @param data The data.
+    * @param length The length of the data.
+    * @param crc The start value, used to continue a previous calculation.
+    * @return The CRC.
+    */
+   static uint16_t crc16(const uint8_t *data, uint16_t length, uint16_t crc = 0xFFFFu);
+
+private:
+   static uint16_t imageSize(uint16_t count, uint16_t object_size);
+
+   template <typename T>
+   static uint16_t saveBank(const T *bank, uint16_t count, SnapshotType_e type,
+                            uint16_t object_size, uint8_t *buffer, uint16_t size);
+
+   template <typename T>
+   static bool restoreBank(T *bank, uint16_t count, SnapshotType_e type,
+                           uint16_t object_size, const uint8_t *buffer, uint16_t size);
+};
+
+#endif /* _SNAPSHOT_H_ */
@@ -0,0 +1,111 @@
+/**
+ * @file SnapshotStream.cpp
+ * @brief Implementation file for the little endian reader and writer of snapshot images.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "SnapshotStream.h"
+
+SnapshotWriter::SnapshotWriter(uint8_t *buffer, uint16_t size) :
+   m_buffer(buffer), m_size(size), m_pos(0), m_valid(true)
+{
+}
+
+void SnapshotWriter::writeU8(uint8_t value)
+{
+   if (m_pos < m_size)
+   {
+      m_buffer[m_pos++] = value;
+   }
+   else
+   {
+      m_valid = false;
+   }
+}
+
+void SnapshotWriter::writeU16(uint16_t value)
+{
+   writeU8(static_cast<uint8_t>(value));
+   writeU8(static_cast<uint8_t>(value >> 8));
+}
+
+void SnapshotWriter::writeU32(uint32_t value)
+{
+   writeU16(static_cast<uint16_t>(value));
+   writeU16(static_cast<uint16_t>(value >> 16));
+}
+
+void SnapshotWriter::writeU64(uint64_t value)
+{
+   writeU32(static_cast<uint32_t>(value));
+   writeU32(static_cast<uint32_t>(value >> 32));
+}
+
+void SnapshotWriter::writeTime(EdgeTime_t value)
+{
+#if EDGE_TIME_64BIT == 1
+   writeU64(value);
+#else
+   writeU32(value);
+#endif
+}
+
+uint16_t SnapshotWriter::length(void) const
+{
+   return m_pos;
+}
+
+bool SnapshotWriter::isValid(void) const
+{
+   return m_valid;
+}
+
+
+SnapshotReader::SnapshotReader(const uint8_t *buffer, uint16_t size) :
+   m_buffer(buffer), m_size(size), m_pos(0), m_valid(true)
+{
+}
+
+uint8_t SnapshotReader::readU8(void)
+{
+   if (m_pos < m_size)
+   {
+      return m_buffer[m_pos++];
+   }
+   m_valid = false;
+   return 0;
+}
+
+uint16_t SnapshotReader::readU16(void)
+{
+   uint16_t value = readU8();
+   return value | static_cast<uint16_t>(readU8() << 8);
+}
+
+uint32_t SnapshotReader::readU32(void)
+{
+   uint32_t value = readU16();
+   return value | (static_cast<uint32_t>(readU16()) << 16);
+}
+
+uint64_t SnapshotReader::readU64(void)
+{
+   uint64_t value = readU32();
+   return value | (static_cast<uint64_t>(readU32()) << 32);
+}
+
+EdgeTime_t SnapshotReader::readTime(void)
+{
+#if EDGE_TIME_64BIT == 1
+   return readU64();
+#else
+   return readU32();
+#endif
+}
+
+bool SnapshotReader::isValid(void) const
+{
+   return m_valid;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file SnapshotStream.h
+ * @brief Header file for the little endian reader and writer of snapshot images.
+ *
+ * Edge and Puls serialize their state with these classes. The header only
+ * depends on Edge.h, so the detectors do not depend on the Snapshot class.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _SNAPSHOT_STREAM_H_
+#define _SNAPSHOT_STREAM_H_
+
+#include <stdint.h>
+#include "Edge.h"
+
+/**
+ * @brief Size of a timestamp in bytes.
+ */
+#define SNAPSHOT_TIME_SIZE ((uint16_t)sizeof(EdgeTime_t))
+
+/**
+ * @brief Class writing little endian values into a buffer.
+ */
+class SnapshotWriter
+{
+public:
+   /**
+    * @brief Constructor for the SnapshotWriter class.
+    * @param buffer The destination buffer.
+    * @param size The size of the destination buffer.
+    */
+   SnapshotWriter(uint8_t *buffer, uint16_t size);
+
+   void writeU8(uint8_t value);
+   void writeU16(uint16_t value);
+   void writeU32(uint32_t value);
+   void writeU64(uint64_t value);
+
+   /**
+    * @brief Writes a timestamp with SNAPSHOT_TIME_SIZE bytes.
+    * @param value The timestamp.
+    */
+   void writeTime(EdgeTime_t value);
+
+   /**
+    * @brief Gets the number of written bytes.
+    * @return The number of written bytes.
+    */
+   uint16_t length(void) const;
+
+   /**
+    * @brief Checks if all values did fit into the buffer.
+    * @return true if no value was truncated.
+    */
+   bool isValid(void) const;
+
+private:
+   uint8_t *m_buffer; /**< Destination buffer */
+   uint16_t m_size;   /**< Size of the destination buffer */
+   uint16_t m_pos;    /**< Current write position */
+   bool m_valid;      /**< False after an overflow */
+};
+
+/**
+ * @brief Class reading little endian values from a buffer.
+ */
+class SnapshotReader
+{
+public:
+   /**
+    * @brief Constructor for the SnapshotReader class.
+    * @param buffer The source buffer.
+    * @param size The size of the source buffer.
+    */
+   SnapshotReader(const uint8_t *buffer, uint16_t size);
+
+   uint8_t readU8(void);
+   uint16_t readU16(void);
+   uint32_t readU32(void);
+   uint64_t readU64(void);
+
+   /**
+    * @brief Reads a timestamp with SNAPSHOT_TIME_SIZE bytes.
+    * @return The timestamp.
+    */
+   EdgeTime_t readTime(void);
+
+   /**
+    * @brief Checks if all values could be read from the buffer.
+    * @return true if no read was beyond the end of the buffer.
+    */
+   bool isValid(void) const;
+
+private:
+   const uint8_t *m_buffer; /**< Source buffer */
+   uint16_t m_size;         /**< Size of the source buffer */
+   uint16_t m_pos;          /**< Current read position */
+   bool m_valid;            /**< False after an underflow */
+};
+
+#endif /* _SNAPSHOT_STREAM_H_ */
@@ -0,0 +1,436 @@
+/**
+ * @file Timeline.cpp
+ * @brief Implementation file for the Timeline class for multi-channel edge merging.
+ *
+ * This file contains the method implementations for the Timeline class, providing
+ * the k-way merge of channel edge queues and the channel to channel measurements.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "Timeline.h"
+#include "Timeline_DebugIf.h"  // For debugging macros
+
+#define TIMELINE_EDGE_INDEX(edge) ((edge) == EDGE_RISING ? 0u : 1u)
+
+/**
+ * @brief Constructor for the Timeline class.
+ */
+Timeline::Timeline(void) : m_channel_count(0), m_heap_size(0), m_measurement_count(0)
+{
+   clear();
+}
+
+Timeline::~Timeline()
+{
+   // Destructor logic if needed
+}
+
+
+int8_t Timeline::attach(Edge &edge)
+{
+   int8_t channel = addChannel();
+
+   if (channel != TIMELINE_INVALID)
+   {
+      m_channels[channel].m_source = &edge;
+   }
+   return channel;
+}
+
+
+int8_t Timeline::addChannel(void)
+{
+   if (m_channel_count >= TIMELINE_MAX_CHANNELS)
+   {
+      DBIF_LOG_WARN("No channel left");
+      return TIMELINE_INVALID;
+   }
+
+   TimelineChannel_t &ch = m_channels[m_channel_count];
+   ch.m_source = nullptr;
+   ch.m_head = 0;
+   ch.m_count = 0;
+   ch.m_dropped = 0;
+   ch.m_seen[0] = ch.m_seen[1] = 0;
+   ch.m_last_time[0] = ch.m_last_time[1] = 0;
+   ch.m_period[0] = ch.m_period[1] = 0;
+
+   DBIF_LOG_DEBUG_1("Channel added = %i", m_channel_count);
+   return static_cast<int8_t>(m_channel_count++);
+}
+
+
+void Timeline::poll(void)
+{
+   for (uint8_t channel = 0; channel < m_channel_count; channel++)
+   {
+      if (m_channels[channel].m_source != nullptr)
+      {
+         push(channel, m_channels[channel].m_source->info());
+      }
+   }
+}
+
+
+bool Timeline::push(uint8_t channel, EdgeInfo_t edge)
+{
+   if (channel >= m_channel_count || edge.m_edge == EDGE_NO_EDGE)
+   {
+      return false;
+   }
+
+   TimelineChannel_t &ch = m_channels[channel];
+   if (ch.m_count >= TIMELINE_QUEUE_SIZE)
+   {
+      ch.m_dropped++;
+      DBIF_LOG_WARN("Channel %i queue full - Dropped %i", channel, ch.m_dropped);
+      return false;
+   }
+
+   ch.m_queue[(ch.m_head + ch.m_count) % TIMELINE_QUEUE_SIZE] = edge;
+   ch.m_count++;
+
+   /* Only the queue head is part of the heap key, so the heap has to be
+    * touched only when the channel was empty before.
+    */
+   if (ch.m_count == 1u)
+   {
+      heapPush(channel);
+   }
+   return true;
+}
+
+
+bool Timeline::next(TimelineEvent_t &event)
+{
+   if (m_heap_size == 0)
+   {
+      return false;
+   }
+
+   uint8_t channel = m_heap[0];
+   TimelineChannel_t &ch = m_channels[channel];
+
+   event.m_channel = channel;
+   event.m_edge = ch.m_queue[ch.m_head].m_edge;
+   event.m_time = ch.m_queue[ch.m_head].m_time;
+
+   ch.m_head = (ch.m_head + 1u) % TIMELINE_QUEUE_SIZE;
+   ch.m_count--;
+
+   if (ch.m_count == 0)
+   {
+      m_heap_size--;
+      m_heap[0] = m_heap[m_heap_size];
+   }
+   if (m_heap_size > 0)
+   {
+      heapSiftDown(0);
+   }
+
+   measure(event);
+   return true;
+}
+
+
+bool Timeline::next(TimelineEvent_t &event, EdgeTime_t horizon)
+{
+   if (m_heap_size == 0 || static_cast<EdgeTimeDiff_t>(horizon - headTime(m_heap[0])) < 0)
+   {
+      return false;
+   }
+   return next(event);
+}
+
+
+uint16_t Timeline::pending(void) const
+{
+   uint16_t count = 0;
+
+   for (uint8_t channel = 0; channel < m_channel_count; channel++)
+   {
+      count += m_channels[channel].m_count;
+   }
+   return count;
+}
+
+
+uint32_t Timeline::getDropCount(uint8_t channel) const
+{
+   return channel < m_channel_count ? m_channels[channel].m_dropped : 0;
+}
+
+
+int8_t Timeline::addMeasurement(uint8_t reference, uint8_t channel, EdgeType_e edge)
+{
+   if (m_measurement_count >= TIMELINE_MAX_MEASUREMENTS ||
+       reference >= m_channel_count || channel >= m_channel_count ||
+       reference == channel || edge == EDGE_NO_EDGE)
+   {
+      DBIF_LOG_WARN("Measurement invalid = %i -> %i", reference, channel);
+      return TIMELINE_INVALID;
+   }
+
+   TimelineMeasurement_t &m = m_measurements[m_measurement_count];
+   m.m_reference = reference;
+   m.m_channel = channel;
+   m.m_edge = edge;
+   resetStats(m.m_delay);
+   resetStats(m.m_phase);
+
+   return static_cast<int8_t>(m_measurement_count++);
+}
+
+
+TimelineStats_t Timeline::getDelay(uint8_t measurement) const
+{
+   TimelineStats_t stats;
+
+   if (measurement < m_measurement_count)
+   {
+      return m_measurements[measurement].m_delay;
+   }
+   resetStats(stats);
+   return stats;
+}
+
+
+TimelineStats_t Timeline::getPhase(uint8_t measurement) const
+{
+   TimelineStats_t stats;
+
+   if (measurement < m_measurement_count)
+   {
+      return m_measurements[measurement].m_phase;
+   }
+   resetStats(stats);
+   return stats;
+}
+
+
+float Timeline::mean(const TimelineStats_t &stats)
+{
+   if (stats.m_count == 0u)
+   {
+      return 0.0f;
+   }
+   double sum = static_cast<double>(stats.m_sum);
+   return static_cast<float>(stats.m_offset + sum / stats.m_count);
+}
+
+
+float Timeline::variance(const TimelineStats_t &stats)
+{
+   if (stats.m_count < 2u)
+   {
+      return 0.0f;
+   }
+   double sum = static_cast<double>(stats.m_sum);
+   double m2 = static_cast<double>(stats.m_sum_sq) - sum * sum / stats.m_count;
+   return m2 > 0.0 ? static_cast<float>(m2 / (stats.m_count - 1u)) : 0.0f;
+}
+
+
+void Timeline::clearMeasurements(void)
+{
+   for (uint8_t i = 0; i < m_measurement_count; i++)
+   {
+      resetStats(m_measurements[i].m_delay);
+      resetStats(m_measurements[i].m_phase);
+   }
+}
+
+
+void Timeline::clear(void)
+{
+   for (uint8_t channel = 0; channel < m_channel_count; channel++)
+   {
+      TimelineChannel_t &ch = m_channels[channel];
+      ch.m_head = 0;
+      ch.m_count = 0;
+      ch.m_dropped = 0;
+      ch.m_seen[0] = ch.m_seen[1] = 0;
+   }
+   m_heap_size = 0;
+   clearMeasurements();
+}
+
+
+EdgeTime_t Timeline::headTime(uint8_t channel) const
+{
+   const TimelineChannel_t &ch = m_channels[channel];
+   return ch.m_queue[ch.m_head].m_time;
+}
+
+
+bool Timeline::before(uint8_t a, uint8_t b) const
+{
+   /* Compare the difference instead of the raw values, so the order stays
+    * correct when the timer wraps around. Equal times are ordered by channel.
+    */
+   EdgeTimeDiff_t diff = static_cast<EdgeTimeDiff_t>(headTime(a) - headTime(b));
+   return diff < 0 || (diff == 0 && a < b);
+}
+
+
+bool Timeline::isPending(uint8_t channel, const TimelineEvent_t &event) const
+{
+   /* Everything older than the event has been merged already, so a queued
+    * edge with the same time can only be at the head of the queue.
+    */
+   const TimelineChannel_t &ch = m_channels[channel];
+   return ch.m_count > 0 && ch.m_queue[ch.m_head].m_time == event.m_time &&
+          ch.m_queue[ch.m_head].m_edge == event.m_edge;
+}
+
+
+void Timeline::heapPush(uint8_t channel)
+{
+   uint8_t pos = m_heap_size++;
+
+   while (pos > 0)
+   {
+      uint8_t parent = (pos - 1u) / 2u;
+      if (!before(channel, m_heap[parent]))
+      {
+         break;
+      }
+      m_heap[pos] = m_heap[parent];
+      pos = parent;
+   }
+   m_heap[pos] = channel;
+}
+
+
+void Timeline::heapSiftDown(uint8_t pos)
+{
+   uint8_t channel = m_heap[pos];
+
+   for (;;)
+   {
+      uint8_t child = 2u * pos + 1u;
+      if (child >= m_heap_size)
+      {
+         break;
+      }
+      if (child + 1u < m_heap_size && before(m_heap[child + 1u], m_heap[child]))
+      {
+         child++;
+      }
+      if (!before(m_heap[child], channel))
+      {
+         break;
+      }
+      m_heap[pos] = m_heap[child];
+      pos = child;
+   }
+   m_heap[pos] = channel;
+}
+
+
+void Timeline::measure(const TimelineEvent_t &event)
+{
+   uint8_t idx = TIMELINE_EDGE_INDEX(event.m_edge);
+   TimelineChannel_t &ch = m_channels[event.m_channel];
+
+   if (ch.m_seen[idx] > 0)
+   {
+      ch.m_period[idx] = event.m_time - ch.m_last_time[idx];
+   }
+   if (ch.m_seen[idx] < 2u)
+   {
+      ch.m_seen[idx]++;
+   }
+   ch.m_last_time[idx] = event.m_time;
+
+   for (uint8_t i = 0; i < m_measurement_count; i++)
+   {
+      TimelineMeasurement_t &m = m_measurements[i];
+      const TimelineChannel_t &ref = m_channels[m.m_reference];
+
+      if (m.m_channel != event.m_channel || m.m_edge != event.m_edge)
+      {
+         continue;
+      }
+
+      /* Equal times are merged by channel index, so a reference edge with the
+       * same time may still be queued. It is the matching edge, not the last one.
+       */
+      if (isPending(m.m_reference, event))
+      {
+         addSample(m.m_delay, 0);
+         if (ref.m_seen[idx] > 0)
+         {
+            addSample(m.m_phase, 0);
+         }
+         continue;
+      }
+      if (ref.m_seen[idx] == 0)
+      {
+         continue;
+      }
+
+      /* The stream is time ordered, so the last reference edge is the most
+       * recent one at or before this edge.
+       */
+      EdgeTime_t elapsed = event.m_time - ref.m_last_time[idx];
+      if (elapsed > static_cast<EdgeTime_t>(INT32_MAX))
+      {
+         /* The reference channel stopped, no sample fits the 32 bit statistics */
+         continue;
+      }
+      int32_t delay = static_cast<int32_t>(elapsed);
+      addSample(m.m_delay, delay);
+
+      if (ref.m_seen[idx] > 1u && ref.m_period[idx] > 0)
+      {
+         int64_t phase = static_cast<int64_t>(delay) * TIMELINE_PHASE_FULL_PERIOD /
+                         static_cast<int64_t>(ref.m_period[idx]);
+         if (phase <= INT32_MAX)
+         {
+            addSample(m.m_phase, static_cast<int32_t>(phase));
+         }
+      }
+   }
+}
+
+
+void Timeline::addSample(TimelineStats_t &stats, int32_t sample)
+{
+   stats.m_count++;
+   stats.m_last = sample;
+
+   if (stats.m_count == 1u)
+   {
+      stats.m_min = sample;
+      stats.m_max = sample;
+      stats.m_offset = sample;
+   }
+   else
+   {
+      if (sample < stats.m_min)
+         stats.m_min = sample;
+      if (sample > stats.m_max)
+         stats.m_max = sample;
+   }
+
+   /* Exact integer sums, mean and variance are derived in the getters */
+   int64_t delta = static_cast<int64_t>(sample) - stats.m_offset;
+   stats.m_sum += delta;
+   uint64_t magnitude = static_cast<uint64_t>(delta < 0 ? -delta : delta);
+   stats.m_sum_sq += magnitude * magnitude;
+}
+
+
+void Timeline::resetStats(TimelineStats_t &stats)
+{
+   stats.m_count = 0;
+   stats.m_last = 0;
+   stats.m_min = 0;
+   stats.m_max = 0;
+   stats.m_offset = 0;
+   stats.m_sum = 0;
+   stats.m_sum_sq = 0;
+}
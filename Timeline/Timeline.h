@@ -0,0 +1,256 @@
+/**
+ * @file Timeline.h
+ * @brief Header file for the Timeline class for multi-channel edge merging.
+ *
+ * The Timeline class collects the edges of several Edge channels and merges
+ * them into one time ordered stream. The merge is done with a binary min-heap
+ * over the channel queues, so taking the next edge costs O(log k) for k
+ * channels. On top of the merged stream the class measures the delay and the
+ * phase between pairs of channels (e.g. clock to data or motor phases) and
+ * keeps running statistics for each measurement.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _TIMELINE_H_
+#define _TIMELINE_H_
+
+#include <stdint.h>
+#include "Edge.h"
+
+/**
+ * @brief Maximum number of channels a Timeline can merge.
+ */
+#ifndef TIMELINE_MAX_CHANNELS
+#define TIMELINE_MAX_CHANNELS 8u
+#endif
+
+/**
+ * @brief Number of edges which can be queued per channel.
+ */
+#ifndef TIMELINE_QUEUE_SIZE
+#define TIMELINE_QUEUE_SIZE 8u
+#endif
+
+/**
+ * @brief Maximum number of channel to channel measurements.
+ */
+#ifndef TIMELINE_MAX_MEASUREMENTS
+#define TIMELINE_MAX_MEASUREMENTS 4u
+#endif
+
+/**
+ * @brief Return value for an invalid channel or measurement index.
+ */
+#define TIMELINE_INVALID -1
+
+/**
+ * @brief Phase resolution. A full period corresponds to 36000 (1/100 degree).
+ */
+#define TIMELINE_PHASE_FULL_PERIOD 36000
+
+/**
+ * @brief Structure holding one edge of the merged stream.
+ */
+typedef struct
+{
+   uint8_t m_channel; /**< Channel the edge was detected on */
+   EdgeType_e m_edge; /**< Type of the detected edge */
+   EdgeTime_t m_time; /**< Time at which the edge was detected */
+} TimelineEvent_t;
+
+/**
+ * @brief Structure holding the running statistics of a measurement.
+ *
+ * Only integer sums are updated per sample. They are kept relative to the
+ * first sample, so they stay small while the samples scatter around a
+ * constant value. Use Timeline::mean() and Timeline::variance() to evaluate them.
+ */
+typedef struct
+{
+   uint32_t m_count;  /**< Number of samples */
+   int32_t m_last;    /**< Last sample */
+   int32_t m_min;     /**< Smallest sample */
+   int32_t m_max;     /**< Largest sample */
+   int32_t m_offset;  /**< First sample, reference of the sums */
+   int64_t m_sum;     /**< Sum of the differences to m_offset */
+   uint64_t m_sum_sq; /**< Sum of the squared differences to m_offset */
+} TimelineStats_t;
+
+/**
+ * @brief Class merging the edges of several channels into one time ordered stream.
+ */
+class Timeline
+{
+public:
+   /**
+    * @brief Constructor for the Timeline class.
+    */
+   Timeline(void);
+
+   /**
+    * @brief Destructor for the Timeline class.
+    */
+   virtual ~Timeline();
+
+   /**
+    * @brief Adds a channel which is fed by an Edge object.
+    * @param edge The Edge object to be polled. It has to outlive the Timeline.
+    * @return The channel index or TIMELINE_INVALID if no channel is left.
+    */
+   int8_t attach(Edge &edge);
+
+   /**
+    * @brief Adds a channel which is fed manually with push().
+    * @return The channel index or TIMELINE_INVALID if no channel is left.
+    */
+   int8_t addChannel(void);
+
+   /**
+    * @brief Reads the current edge of every attached Edge object.
+    *
+    * Has to be called once after every checkEdges() of the attached objects.
+    */
+   void poll(void);
+
+   /**
+    * @brief Queues an edge on a channel.
+    * @param channel The channel index.
+    * @param edge The edge information. EDGE_NO_EDGE entries are ignored.
+    * @return true if the edge was queued, false if it was ignored or the queue is full.
+    */
+   bool push(uint8_t channel, EdgeInfo_t edge);
+
+   /**
+    * @brief Takes the oldest queued edge of all channels.
+    * @param event The merged edge.
+    * @return true if an edge was available.
+    */
+   bool next(TimelineEvent_t &event);
+
+   /**
+    * @brief Takes the oldest queued edge of all channels, if it is not newer than horizon.
+    *
+    * With recorded data every channel has to be fed up to horizon before
+    * calling this method, otherwise an older edge may still be missing.
+    * @param event The merged edge.
+    * @param horizon The latest time which may be returned.
+    * @return true if an edge was available.
+    */
+   bool next(TimelineEvent_t &event, EdgeTime_t horizon);
+
+   /**
+    * @brief Gets the number of queued edges of all channels.
+    * @return The number of queued edges.
+    */
+   uint16_t pending(void) const;
+
+   /**
+    * @brief Gets the number of edges dropped because of a full channel queue.
+    * @param channel The channel index.
+    * @return The number of dropped edges.
+    */
+   uint32_t getDropCount(uint8_t channel) const;
+
+   /**
+    * @brief Adds a delay and phase measurement between two channels.
+    *
+    * Each edge of the given type on channel is related to the most recent edge
+    * of the same type on reference. The delay is the time between both edges,
+    * the phase is the delay relative to the period of the reference channel.
+    * Edges with the same time on both channels have a delay of 0, independent
+    * of the channel numbers. Delays and phases beyond the 32 bit range of the
+    * statistics, e.g. after the reference channel stopped, are skipped.
+    * @param reference The reference channel (e.g. the clock).
+    * @param channel The measured channel (e.g. the data line).
+    * @param edge The edge type to be compared.
+    * @return The measurement index or TIMELINE_INVALID.
+    */
+   int8_t addMeasurement(uint8_t reference, uint8_t channel, EdgeType_e edge = EDGE_RISING);
+
+   /**
+    * @brief Gets the delay statistics of a measurement.
+    * @param measurement The measurement index.
+    * @return The delay statistics in the time unit of the channels.
+    */
+   TimelineStats_t getDelay(uint8_t measurement) const;
+
+   /**
+    * @brief Gets the phase statistics of a measurement.
+    * @param measurement The measurement index.
+    * @return The phase statistics in 1/100 degree.
+    */
+   TimelineStats_t getPhase(uint8_t measurement) const;
+
+   /**
+    * @brief Gets the mean of a statistic.
+    * @param stats The statistic.
+    * @return The mean.
+    */
+   static float mean(const TimelineStats_t &stats);
+
+   /**
+    * @brief Gets the variance of a statistic.
+    * @param stats The statistic.
+    * @return The sample variance.
+    */
+   static float variance(const TimelineStats_t &stats);
+
+   /**
+    * @brief Resets the measurement statistics.
+    */
+   void clearMeasurements(void);
+
+   /**
+    * @brief Drops all queued edges and resets the measurement statistics.
+    */
+   void clear(void);
+
+private:
+   /**
+    * @brief Structure holding the edge queue of one channel.
+    */
+   typedef struct
+   {
+      Edge *m_source;                         /**< Polled Edge object or nullptr */
+      EdgeInfo_t m_queue[TIMELINE_QUEUE_SIZE]; /**< Ring buffer of queued edges */
+      uint8_t m_head;                         /**< Index of the oldest queued edge */
+      uint8_t m_count;                        /**< Number of queued edges */
+      uint32_t m_dropped;                     /**< Number of dropped edges */
+      EdgeTime_t m_last_time[2];              /**< Last rising / falling edge time */
+      EdgeTime_t m_period[2];                 /**< Last rising / falling edge period */
+      uint8_t m_seen[2];                      /**< Number of rising / falling edges seen (saturated at 2) */
+   } TimelineChannel_t;
+
+   /**
+    * @brief Structure holding one channel to channel measurement.
+    */
+   typedef struct
+   {
+      uint8_t m_reference;     /**< Reference channel */
+      uint8_t m_channel;       /**< Measured channel */
+      EdgeType_e m_edge;       /**< Compared edge type */
+      TimelineStats_t m_delay; /**< Delay statistics */
+      TimelineStats_t m_phase; /**< Phase statistics */
+   } TimelineMeasurement_t;
+
+   EdgeTime_t headTime(uint8_t channel) const;
+   bool before(uint8_t a, uint8_t b) const;
+   bool isPending(uint8_t channel, const TimelineEvent_t &event) const;
+   void heapPush(uint8_t channel);
+   void heapSiftDown(uint8_t pos);
+   void measure(const TimelineEvent_t &event);
+   static void addSample(TimelineStats_t &stats, int32_t sample);
+   static void resetStats(TimelineStats_t &stats);
+
+private:
+   TimelineChannel_t m_channels[TIMELINE_MAX_CHANNELS];         /**< Channel queues */
+   uint8_t m_channel_count;                                     /**< Number of used channels */
+   uint8_t m_heap[TIMELINE_MAX_CHANNELS];                       /**< Min-heap of channels with queued edges */
+   uint8_t m_heap_size;                                         /**< Number of channels in the heap */
+   TimelineMeasurement_t m_measurements[TIMELINE_MAX_MEASUREMENTS]; /**< Channel to channel measurements */
+   uint8_t m_measurement_count;                                 /**< Number of used measurements */
+};
+
+#endif /* _TIMELINE_H_ */
@@ -0,0 +1,530 @@
+/**
+ * @file SignalAnalyzer.cpp
+ * @brief Command line capture analyzer running the library detectors over recorded traces.
+ *
+ * Every configured channel is fed into its own Puls object, exactly as on the
+ * target, with micros() / millis() following the trace time. Parsing and
+ * detection run on separate threads connected by a bounded batch queue.
+ *
+ * Trace formats (one sample per row / record, levels of up to 32 channels):
+ *   csv  "time_us,level_ch0,level_ch1,..."  a non numeric first line is skipped
+ *   bin  little endian records of uint32 time_us and uint32 level mask (bit n = channel n)
+ *
+ * Pulse timeouts are evaluated at sample times only, like a target polling at
+ * the sample rate of the trace.
+ *
+ * The Makefile builds the library with EDGE_TIME_64BIT, so pulse times and widths
+ * do not wrap on long traces. Pulse records of the -b output are little endian
+ * uint8 channel, uint8 type, time and width, with time and width as uint64
+ * (18 byte records), or as uint32 in a TIME64=0 build (10 byte records).
+ *
+ * Usage: signal_analyzer [-f csv|bin] -c SPEC [-c SPEC ...] [-o pulses.csv] [-b pulses.bin] [-s summary.csv] TRACE
+ *   SPEC = CHANNEL:high|low|both[:debounce=N][:timeout=N][:res=ms|us]
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "Puls.h"
+
+#define ANALYZER_MAX_CHANNELS 32u
+#define ANALYZER_BATCH_SIZE 16384u
+#define ANALYZER_QUEUE_DEPTH 8u
+#define ANALYZER_READ_SIZE (1u << 20)
+
+typedef enum
+{
+   TRACE_FORMAT_CSV = 0,
+   TRACE_FORMAT_BIN = 1
+} TraceFormat_e;
+
+/**
+ * @brief Structure holding one trace sample.
+ */
+typedef struct
+{
+   uint64_t m_time;   /**< Sample time in microseconds */
+   uint32_t m_levels; /**< Level of every channel, bit n = channel n */
+} TraceSample_t;
+
+typedef std::vector<TraceSample_t> TraceBatch_t;
+
+/**
+ * @brief Structure holding the configuration and the counters of one channel.
+ */
+typedef struct
+{
+   uint8_t m_index;              /**< Channel index in the trace */
+   PulsType_e m_trigger;         /**< Pulse trigger */
+   uint32_t m_debounce;          /**< Debounce time */
+   uint32_t m_timeout;           /**< Pulse timeout */
+   PulsResolution_e m_resolution;/**< Time resolution */
+   std::unique_ptr<Puls> m_puls; /**< Detector */
+   uint32_t m_puls_count;        /**< Last seen pulse count */
+   uint32_t m_error_count;       /**< Last seen error count */
+   uint32_t m_high_count;        /**< Number of high pulses */
+   uint32_t m_low_count;         /**< Number of low pulses */
+} AnalyzerChannel_t;
+
+/**
+ * @brief Bounded queue handing sample batches from the parser to the detector.
+ */
+class BatchQueue
+{
+public:
+   BatchQueue(size_t depth) : m_depth(depth), m_closed(false) {}
+
+   void push(std::unique_ptr<TraceBatch_t> batch)
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_not_full.wait(lock, [this] { return m_batches.size() < m_depth; });
+      m_batches.push_back(std::move(batch));
+      m_not_empty.notify_one();
+   }
+
+   void close(void)
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_closed = true;
+      m_not_empty.notify_all();
+   }
+
+   std::unique_ptr<TraceBatch_t> pop(void)
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_not_empty.wait(lock, [this] { return !m_batches.empty() || m_closed; });
+      if (m_batches.empty())
+      {
+         return nullptr;
+      }
+      std::unique_ptr<TraceBatch_t> batch = std::move(m_batches.front());
+      m_batches.pop_front();
+      m_not_full.notify_one();
+      return batch;
+   }
+
+private:
+   size_t m_depth;
+   bool m_closed;
+   std::deque<std::unique_ptr<TraceBatch_t>> m_batches;
+   std::mutex m_mutex;
+   std::condition_variable m_not_full;
+   std::condition_variable m_not_empty;
+};
+
+
+static void usage(void)
+{
+   fprintf(stderr,
+           "usage: signal_analyzer [-f csv|bin] -c SPEC [-c SPEC ...] [-o pulses.csv] [-b pulses.bin] [-s summary.csv] TRACE\n"
+           "  SPEC = CHANNEL:high|low|both[:debounce=N][:timeout=N][:res=ms|us]\n"
+           "  csv trace: time_us,level_ch0,level_ch1,...\n"
+           "  bin trace: little endian uint32 time_us, uint32 level mask per sample\n");
+}
+
+
+static bool parseChannel(const char *spec, AnalyzerChannel_t &channel)
+{
+   std::string text(spec);
+   std::vector<std::string> fields;
+   size_t start = 0;
+
+   for (;;)
+   {
+      size_t end = text.find(':', start);
+      fields.push_back(text.substr(start, end - start));
+      if (end == std::string::npos)
+         break;
+      start = end + 1;
+   }
+   if (fields.size() < 2)
+   {
+      return false;
+   }
+
+   char *end = nullptr;
+   unsigned long index = strtoul(fields[0].c_str(), &end, 10);
+   if (*end != '\0' || index >= ANALYZER_MAX_CHANNELS)
+   {
+      return false;
+   }
+
+   channel.m_index = static_cast<uint8_t>(index);
+   channel.m_debounce = 0;
+   channel.m_timeout = 0;
+   channel.m_resolution = PULS_RESOLUTION_MS;
+
+   if (fields[1] == "high")
+      channel.m_trigger = PULS_HIGH;
+   else if (fields[1] == "low")
+      channel.m_trigger = PULS_LOW;
+   else if (fields[1] == "both")
+      channel.m_trigger = PULS_BOTH;
+   else
+      return false;
+
+   for (size_t i = 2; i < fields.size(); i++)
+   {
+      const std::string &option = fields[i];
+      if (option.compare(0, 9, "debounce=") == 0)
+         channel.m_debounce = static_cast<uint32_t>(strtoul(option.c_str() + 9, nullptr, 10));
+      else if (option.compare(0, 8, "timeout=") == 0)
+         channel.m_timeout = static_cast<uint32_t>(strtoul(option.c_str() + 8, nullptr, 10));
+      else if (option == "res=us")
+         channel.m_resolution = PULS_RESOLUTION_US;
+      else if (option == "res=ms")
+         channel.m_resolution = PULS_RESOLUTION_MS;
+      else
+         return false;
+   }
+   return true;
+}
+
+
+/**
+ * @brief Parses the complete lines of a CSV chunk.
+ * @return The number of consumed bytes, the rest is an incomplete line.
+ */
+static size_t parseCsv(const char *data, size_t length, TraceBatch_t &batch, bool &skip_header)
+{
+   size_t pos = 0;
+
+   for (;;)
+   {
+      const char *line = data + pos;
+      const char *eol = static_cast<const char *>(memchr(line, '\n', length - pos));
+      if (eol == nullptr)
+      {
+         return pos;
+      }
+      pos = static_cast<size_t>(eol - data) + 1u;
+
+      if (skip_header)
+      {
+         skip_header = false;
+         if (*line < '0' || *line > '9')
+            continue;
+      }
+
+      const char *p = line;
+      uint64_t time = 0;
+      while (p < eol && *p >= '0' && *p <= '9')
+      {
+         time = time * 10u + static_cast<uint64_t>(*p - '0');
+         p++;
+      }
+      if (p == line)
+      {
+         continue;
+      }
+
+      uint32_t levels = 0;
+      uint32_t channel = 0;
+      while (p < eol && channel < ANALYZER_MAX_CHANNELS)
+      {
+         if (*p == ',')
+         {
+            p++;
+            while (p < eol && *p == ' ')
+               p++;
+            if (p < eol && *p == '1')
+               levels |= (1u << channel);
+            channel++;
+         }
+         else
+         {
+            p++;
+         }
+      }
+      batch.push_back({ time, levels });
+   }
+}
+
+
+static void parserThread(FILE *file, TraceFormat_e format, BatchQueue &queue, uint64_t &bytes)
+{
+   std::vector<char> buffer(ANALYZER_READ_SIZE + 8u);
+   std::unique_ptr<TraceBatch_t> batch(new TraceBatch_t());
+   size_t pending = 0;
+   bool skip_header = true;
+   uint64_t time_high = 0;
+   uint32_t time_last = 0;
+
+   batch->reserve(ANALYZER_BATCH_SIZE);
+   for (;;)
+   {
+      size_t read = fread(buffer.data() + pending, 1, ANALYZER_READ_SIZE - pending, file);
+      if (read == 0)
+      {
+         break;
+      }
+      bytes += read;
+      size_t length = pending + read;
+      size_t consumed = 0;
+
+      if (format == TRACE_FORMAT_CSV)
+      {
+         consumed = parseCsv(buffer.data(), length, *batch, skip_header);
+      }
+      else
+      {
+         const uint8_t *data = reinterpret_cast<const uint8_t *>(buffer.data());
+         for (; consumed + 8u <= length; consumed += 8u)
+         {
+            const uint8_t *r = data + consumed;
+            uint32_t time = r[0] | (r[1] << 8) | (r[2] << 16) | (static_cast<uint32_t>(r[3]) << 24);
+            uint32_t levels = r[4] | (r[5] << 8) | (r[6] << 16) | (static_cast<uint32_t>(r[7]) << 24);
+            /* Extend the 32 bit record time, so millis() follows the trace past a wrap */
+            if (time < time_last)
+               time_high += (1ULL << 32);
+            time_last = time;
+            batch->push_back({ time_high | time, levels });
+         }
+      }
+
+      pending = length - consumed;
+      memmove(buffer.data(), buffer.data() + consumed, pending);
+
+      if (batch->size() >= ANALYZER_BATCH_SIZE)
+      {
+         queue.push(std::move(batch));
+         batch.reset(new TraceBatch_t());
+         batch->reserve(ANALYZER_BATCH_SIZE);
+      }
+   }
+
+   if (format == TRACE_FORMAT_CSV && pending > 0)
+   {
+      /* Last line without a line break */
+      buffer[pending] = '\n';
+      parseCsv(buffer.data(), pending + 1u, *batch, skip_header);
+   }
+   if (!batch->empty())
+   {
+      queue.push(std::move(batch));
+   }
+   queue.close();
+}
+
+
+static void writePuls(FILE *csv, FILE *bin, uint8_t channel, PulsType_e type, EdgeTime_t time, EdgeTime_t width)
+{
+   if (csv != nullptr)
+   {
+      const char *name = (type == PULS_HIGH) ? "high" : (type == PULS_LOW) ? "low" : "timeout";
+      fprintf(csv, "%u,%s,%llu,%llu\n", channel, name,
+              static_cast<unsigned long long>(time), static_cast<unsigned long long>(width));
+   }
+   if (bin != nullptr)
+   {
+      uint8_t record[2u + 2u * sizeof(EdgeTime_t)];
+
+      record[0] = channel;
+      record[1] = static_cast<uint8_t>(type);
+      for (size_t i = 0; i < sizeof(EdgeTime_t); i++)
+      {
+         record[2u + i] = static_cast<uint8_t>(time >> (8u * i));
+         record[2u + sizeof(EdgeTime_t) + i] = static_cast<uint8_t>(width >> (8u * i));
+      }
+      fwrite(record, sizeof(record), 1, bin);
+   }
+}
+
+
+static uint64_t detectorThread(std::vector<AnalyzerChannel_t> &channels, BatchQueue &queue, FILE *csv, FILE *bin)
+{
+   uint64_t samples = 0;
+
+   while (std::unique_ptr<TraceBatch_t> batch = queue.pop())
+   {
+      for (const TraceSample_t &sample : *batch)
+      {
+         hostClockSet(sample.m_time);
+
+         for (AnalyzerChannel_t &ch : channels)
+         {
+            Puls &puls = *ch.m_puls;
+            puls.checkPuls(static_cast<uint8_t>((sample.m_levels >> ch.m_index) & 1u));
+
+            uint32_t count = puls.getPulsCount();
+            if (count != ch.m_puls_count)
+            {
+               ch.m_puls_count = count;
+               PulsType_e type = puls.getPulsType();
+               if (type == PULS_HIGH)
+                  ch.m_high_count++;
+               else
+                  ch.m_low_count++;
+               writePuls(csv, bin, ch.m_index, type, puls.getPulsTime(), static_cast<EdgeTime_t>(puls.getPulsWidth()));
+            }
+
+            uint32_t errors = puls.getErrorCount();
+            if (errors != ch.m_error_count)
+            {
+               ch.m_error_count = errors;
+               EdgeTime_t now = Edge::clock(static_cast<EdgeResolution_e>(ch.m_resolution));
+               writePuls(csv, bin, ch.m_index, PULS_TIMEOUT, now, 0);
+            }
+         }
+      }
+      samples += batch->size();
+   }
+   return samples;
+}
+
+
+static FILE *openOutput(const char *path, const char *mode, std::vector<char> &buffer)
+{
+   FILE *file = fopen(path, mode);
+   if (file == nullptr)
+   {
+      fprintf(stderr, "signal_analyzer: cannot open %s\n", path);
+      exit(EXIT_FAILURE);
+   }
+   buffer.resize(ANALYZER_READ_SIZE);
+   setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+   return file;
+}
+
+
+int main(int argc, char **argv)
+{
+   std::vector<AnalyzerChannel_t> channels;
+   const char *trace_path = nullptr;
+   const char *csv_path = nullptr;
+   const char *bin_path = nullptr;
+   const char *summary_path = nullptr;
+   int format = -1;
+
+   for (int i = 1; i < argc; i++)
+   {
+      const char *arg = argv[i];
+      bool has_value = (i + 1 < argc);
+
+      if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+      {
+         usage();
+         return EXIT_SUCCESS;
+      }
+      else if (strcmp(arg, "-f") == 0 && has_value)
+      {
+         const char *value = argv[++i];
+         if (strcmp(value, "csv") == 0)
+            format = TRACE_FORMAT_CSV;
+         else if (strcmp(value, "bin") == 0)
+            format = TRACE_FORMAT_BIN;
+         else
+         {
+            usage();
+            return EXIT_FAILURE;
+         }
+      }
+      else if (strcmp(arg, "-c") == 0 && has_value)
+      {
+         AnalyzerChannel_t channel = {};
+         if (!parseChannel(argv[++i], channel))
+         {
+            fprintf(stderr, "signal_analyzer: invalid channel %s\n", argv[i]);
+            return EXIT_FAILURE;
+         }
+         channels.push_back(std::move(channel));
+      }
+      else if (strcmp(arg, "-o") == 0 && has_value)
+         csv_path = argv[++i];
+      else if (strcmp(arg, "-b") == 0 && has_value)
+         bin_path = argv[++i];
+      else if (strcmp(arg, "-s") == 0 && has_value)
+         summary_path = argv[++i];
+      else if (arg[0] != '-' && trace_path == nullptr)
+         trace_path = arg;
+      else
+      {
+         usage();
+         return EXIT_FAILURE;
+      }
+   }
+
+   if (trace_path == nullptr || channels.empty())
+   {
+      usage();
+      return EXIT_FAILURE;
+   }
+   if (format < 0)
+   {
+      size_t length = strlen(trace_path);
+      format = (length > 4 && strcmp(trace_path + length - 4, ".csv") == 0) ? TRACE_FORMAT_CSV : TRACE_FORMAT_BIN;
+   }
+
+   FILE *trace = fopen(trace_path, "rb");
+   if (trace == nullptr)
+   {
+      fprintf(stderr, "signal_analyzer: cannot open %s\n", trace_path);
+      return EXIT_FAILURE;
+   }
+
+   std::vector<char> csv_buffer, bin_buffer;
+   FILE *csv = csv_path ? openOutput(csv_path, "w", csv_buffer) : nullptr;
+   FILE *bin = bin_path ? openOutput(bin_path, "wb", bin_buffer) : nullptr;
+   if (csv != nullptr)
+   {
+      fprintf(csv, "channel,type,time,width\n");
+   }
+
+   for (AnalyzerChannel_t &ch : channels)
+   {
+      ch.m_puls.reset(new Puls(ch.m_trigger, LOW, ch.m_timeout, ch.m_debounce));
+      ch.m_puls->pulsResolution(ch.m_resolution);
+   }
+
+   BatchQueue queue(ANALYZER_QUEUE_DEPTH);
+   uint64_t bytes = 0;
+   uint64_t samples = 0;
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   std::thread parser(parserThread, trace, static_cast<TraceFormat_e>(format), std::ref(queue), std::ref(bytes));
+   std::thread detector([&] { samples = detectorThread(channels, queue, csv, bin); });
+   parser.join();
+   detector.join();
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   fclose(trace);
+   if (csv != nullptr)
+      fclose(csv);
+   if (bin != nullptr)
+      fclose(bin);
+
+   std::vector<char> summary_buffer;
+   FILE *summary = summary_path ? openOutput(summary_path, "w", summary_buffer) : stdout;
+   fprintf(summary, "channel,pulses,high,low,errors\n");
+   for (const AnalyzerChannel_t &ch : channels)
+   {
+      fprintf(summary, "%u,%u,%u,%u,%u\n", ch.m_index, ch.m_puls_count, ch.m_high_count, ch.m_low_count, ch.m_error_count);
+   }
+   if (summary != stdout)
+   {
+      fclose(summary);
+   }
+
+   if (seconds <= 0.0)
+   {
+      seconds = 1e-9;
+   }
+   fprintf(stderr, "%llu samples, %.1f MB in %.3f s: %.2f Msamples/s, %.1f MB/s, %zu channels\n",
+           static_cast<unsigned long long>(samples), bytes / 1e6, seconds,
+           samples / seconds / 1e6, bytes / seconds / 1e6, channels.size());
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file Arduino.h
+ * @brief Host replacement of the Arduino core parts used by the library.
+ *
+ * micros() and millis() return the time of the trace sample being processed,
+ * which is set with hostClockSet(). The clock is thread local, so each
+ * detection thread runs on its own trace time.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef bool boolean;
+
+#ifndef HIGH
+#define HIGH 0x1
+#endif
+
+#ifndef LOW
+#define LOW 0x0
+#endif
+
+/**
+ * @brief Sets the clock of the calling thread.
+ * @param time_us The time in microseconds.
+ */
+void hostClockSet(uint64_t time_us);
+
+/**
+ * @brief Gets the clock of the calling thread in microseconds, wrapping like on the target.
+ * @return The time in microseconds.
+ */
+uint32_t micros(void);
+
+/**
+ * @brief Gets the clock of the calling thread in milliseconds, wrapping like on the target.
+ * @return The time in milliseconds.
+ */
+uint32_t millis(void);
+
+#endif /* _HOST_ARDUINO_H_ */
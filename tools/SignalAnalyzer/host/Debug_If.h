@@ -0,0 +1,18 @@
+/**
+ * @file Debug_If.h
+ * @brief Host replacement of the DebugIf library. All log output is dropped.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _HOST_DEBUG_IF_H_
+#define _HOST_DEBUG_IF_H_
+
+#define DBIF_LOG_DEBUG_0(...) do { } while (0)
+#define DBIF_LOG_DEBUG_1(...) do { } while (0)
+#define DBIF_LOG_INFO(...)    do { } while (0)
+#define DBIF_LOG_WARN(...)    do { } while (0)
+#define DBIF_LOG_ERROR(...)   do { } while (0)
+
+#endif /* _HOST_DEBUG_IF_H_ */
@@ -0,0 +1,15 @@
+/**
+ * @file Event.h
+ * @brief Host replacement of the Events library. Event outputs are not used by the analyzer.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#ifndef _HOST_EVENT_H_
+#define _HOST_EVENT_H_
+
+#define EVENT_SIGNAL(name, type)
+#define EVENT_EMIT(signal, ...) do { } while (0)
+
+#endif /* _HOST_EVENT_H_ */
@@ -0,0 +1,26 @@
+/**
+ * @file HostClock.cpp
+ * @brief Trace driven clock for the host replacement of the Arduino core.
+ *
+ * @author AP02
+ * @date 19.10.2026
+ */
+
+#include "Arduino.h"
+
+static thread_local uint64_t s_time_us = 0;
+
+void hostClockSet(uint64_t time_us)
+{
+   s_time_us = time_us;
+}
+
+uint32_t micros(void)
+{
+   return static_cast<uint32_t>(s_time_us);
+}
+
+uint32_t millis(void)
+{
+   return static_cast<uint32_t>(s_time_us / 1000u);
+}